@@ -0,0 +1,129 @@
+// benchmark_fisheye.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include <iostream>
+#include <random>
+
+#include "port/config.h"
+#include "system.h"
+#include "camera/kannala_brandt.h"
+#include "util/statistics.h"
+
+using namespace tello_basic;
+
+
+/**
+ * throughput and accuracy of Kannala_Brandt against cv::fisheye.
+ * uses mono camera if it is a fisheye, else a typical wide-angle lens.
+ */
+int main(int argc, char **argv)
+{
+    // configure system =======================================================
+    std::string configuration_file_path = "./config/system_config.yaml";
+    
+    System::Ptr system = std::make_shared<System>(configuration_file_path);    
+    assert(system->initialize() == true);
+
+    Camera::Ptr camera = system->get_mono_camera();
+    Camera::Ptr fisheye = camera;
+    if (camera->camera_model_ != Camera::KANNALA_BRANDT)
+    {
+        cv::Mat cameraMatrix(cv::Matx33d(285, 0, 320,  0, 285, 240,  0, 0, 1));
+        cv::Mat distCoeffs(cv::Matx41d(-0.013, 0.041, -0.038, 0.008));
+        fisheye = std::make_shared<Kannala_Brandt>(
+            std::vector<cv::Mat>{cameraMatrix, distCoeffs});
+        std::cout << "mono camera is not fisheye, using wide-angle example" << std::endl;
+    }
+    const cv::Mat& K = fisheye->cameraMatrix_;
+    const cv::Mat& D = fisheye->distCoeffs_;
+
+    // random points up to 80 deg off axis ====================================
+    long num_points = argc > 1 ? std::atol(argv[1]) : 100000;
+    int num_repetitions = 20;
+
+    MatX3 p3Ds_camera(num_points, 3);
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> angle_off_axis(0, 80 * CV_PI / 180);
+    std::uniform_real_distribution<double> angle_around_axis(0, 2 * CV_PI);
+    std::uniform_real_distribution<double> distance(0.5, 5.0);
+    for (long i = 0; i < num_points; ++i)
+    {
+        double theta = angle_off_axis(generator);
+        double phi = angle_around_axis(generator);
+        double depth = distance(generator);
+        p3Ds_camera.row(i) << depth * std::sin(theta) * std::cos(phi), 
+            depth * std::sin(theta) * std::sin(phi), depth * std::cos(theta);
+    }
+
+    std::vector<cv::Point3d> p3Ds_cv(num_points);
+    for (long i = 0; i < num_points; ++i)
+        p3Ds_cv[i] = cv::Point3d(p3Ds_camera(i, 0), p3Ds_camera(i, 1), p3Ds_camera(i, 2));
+
+    MatX2 p2Ds_pixel;
+    MatX3 p3Ds_normalized;
+    std::vector<cv::Point2d> p2Ds_cv, p2Ds_normalized_cv;
+    cv::Vec3d zero(0, 0, 0);
+
+    // throughput =============================================================
+    Statistics project, unproject, project_cv, unproject_cv; // [s]
+    for (int i = 0; i < num_repetitions; ++i)
+    {
+        Timestamp t0 = Clock::now();
+        fisheye->project(p3Ds_camera, p2Ds_pixel);
+        Timestamp t1 = Clock::now();
+        fisheye->unproject(p2Ds_pixel, p3Ds_normalized);
+        Timestamp t2 = Clock::now();
+        cv::fisheye::projectPoints(p3Ds_cv, p2Ds_cv, zero, zero, K, D);
+        Timestamp t3 = Clock::now();
+        cv::fisheye::undistortPoints(p2Ds_cv, p2Ds_normalized_cv, K, D);
+        Timestamp t4 = Clock::now();
+
+        project.add(std::chrono::duration<double>(t1 - t0).count());
+        unproject.add(std::chrono::duration<double>(t2 - t1).count());
+        project_cv.add(std::chrono::duration<double>(t3 - t2).count());
+        unproject_cv.add(std::chrono::duration<double>(t4 - t3).count());
+    }
+
+    std::cout << num_points << " points, median of " << num_repetitions << " runs" << std::endl;
+    std::cout << "                 project [Mpt/s]  unproject [Mpt/s]" << std::endl;
+    std::cout << "Kannala_Brandt\t " << num_points / project.median() / 1e6 
+              << "\t\t  " << num_points / unproject.median() / 1e6 << std::endl;
+    std::cout << "cv::fisheye\t " << num_points / project_cv.median() / 1e6 
+              << "\t\t  " << num_points / unproject_cv.median() / 1e6 << std::endl;
+
+    // accuracy ===============================================================
+    // reference unprojection solved to convergence
+    cv::TermCriteria converged(cv::TermCriteria::COUNT | cv::TermCriteria::EPS, 100, 1e-12);
+    cv::fisheye::undistortPoints(p2Ds_cv, p2Ds_normalized_cv, K, D, 
+        cv::noArray(), cv::noArray(), converged);
+
+    Statistics project_error, unproject_error; // [pixel]
+    for (long i = 0; i < num_points; ++i)
+    {
+        project_error.add(std::hypot(
+            p2Ds_pixel(i, 0) - p2Ds_cv[i].x, p2Ds_pixel(i, 1) - p2Ds_cv[i].y));
+
+        // angle between rays, as pixels at focal length
+        Vec3 ray = p3Ds_normalized.row(i).transpose();
+        Vec3 ray_cv(p2Ds_normalized_cv[i].x, p2Ds_normalized_cv[i].y, 1);
+        double angle = std::atan2(ray.cross(ray_cv).norm(), ray.dot(ray_cv));
+        unproject_error.add(fisheye->fx_ * angle);
+    }
+
+    std::cout << "project   error vs cv::fisheye [px]: mean " << project_error.mean() 
+              << ", max " << project_error.max() << std::endl;
+    std::cout << "unproject ray error vs cv::fisheye [px at f]: mean " << unproject_error.mean() 
+              << ", max " << unproject_error.max() << std::endl;
+
+    return 0;
+}
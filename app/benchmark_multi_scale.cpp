@@ -0,0 +1,127 @@
+// benchmark_multi_scale.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include <iostream>
+
+#include "port/config.h"
+#include "system.h"
+#include "marker/aruco_detector.h"
+#include "util/statistics.h"
+
+using namespace tello_basic;
+
+
+/**
+ * compare full-resolution and coarse-to-fine detection on recorded video.
+ * full-resolution pose is taken as reference for pose error.
+ */
+int main(int argc, char **argv)
+{
+    // configure system =======================================================
+    std::string configuration_file_path = "./config/system_config.yaml";
+    
+    System::Ptr system = std::make_shared<System>(configuration_file_path);    
+    assert(system->initialize() == true);
+
+    std::string predifined_dictionary_name = Config::read<std::string>("predifined_dictionary_name");
+    float marker_length = Config::read<float>("marker_length");
+    int target_id = Config::read<int>("target_ID");
+
+    // detectors ==============================================================
+    // only multi-scale differs: every frame is a full-frame, untiled
+    // detection with wide default parameters
+    ArUco_Detector full_resolution(target_id, predifined_dictionary_name, 
+        marker_length, system->get_mono_camera());
+    ArUco_Detector multi_scale(target_id, predifined_dictionary_name, 
+        marker_length, system->get_mono_camera());
+    for (ArUco_Detector* aruco_detector : {&full_resolution, &multi_scale})
+    {
+        aruco_detector->set_roi_tracking(false);
+        aruco_detector->set_corner_tracking(false);
+        aruco_detector->set_adaptive_parameters(false);
+        aruco_detector->set_detection_threads(1);
+    }
+    full_resolution.set_multi_scale(false);
+    multi_scale.set_multi_scale(true);
+
+    // port ===================================================================
+    std::string video_file_path = argc > 1 ? argv[1] : Config::read<std::string>("video_file_path");
+    cv::VideoCapture cap(video_file_path);
+    if (!cap.isOpened()) 
+    {
+        std::cerr << "ERROR: could not open " << video_file_path << std::endl;
+        return -1;
+    }
+
+    // run ////////////////////////////////////////////////////////////////////
+    cv::Mat image, image_gray;
+    Detection_Result result_full, result_multi;
+    Statistics latency_full, latency_multi; // [ms]
+    Statistics translation_error, rotation_error; // [m], [deg]
+    int num_frames = 0, num_hits_full = 0, num_hits_multi = 0;
+
+    full_resolution.reset_tracking();
+    multi_scale.reset_tracking();
+
+    while (cap.read(image) && !image.empty())
+    {
+        cv::cvtColor(image, image_gray, cv::COLOR_BGR2GRAY);
+        Timestamp t = Clock::now();
+
+        Timestamp t0 = Clock::now();
+        full_resolution.track_frame(image_gray, t, result_full);
+        Timestamp t1 = Clock::now();
+        multi_scale.track_frame(image_gray, t, result_multi);
+        Timestamp t2 = Clock::now();
+
+        latency_full.add(std::chrono::duration<double, std::milli>(t1 - t0).count());
+        latency_multi.add(std::chrono::duration<double, std::milli>(t2 - t1).count());
+
+        ++num_frames;
+        num_hits_full += result_full.target_found;
+        num_hits_multi += result_multi.target_found;
+
+        // pose error =========================================================
+        if (result_full.target_found && result_multi.target_found)
+        {
+            translation_error.add(cv::norm(result_multi.tvec - result_full.tvec));
+
+            // angle of R_full^T R_multi
+            cv::Matx33d R_full, R_multi;
+            cv::Rodrigues(result_full.rvec, R_full);
+            cv::Rodrigues(result_multi.rvec, R_multi);
+            cv::Vec3d rvec_error;
+            cv::Rodrigues(R_full.t() * R_multi, rvec_error);
+            rotation_error.add(cv::norm(rvec_error) * 180 / CV_PI);
+        }
+    }
+
+    // report /////////////////////////////////////////////////////////////////
+    std::cout << "frames: " << num_frames << std::endl;
+    std::cout << "target found: full " << num_hits_full 
+              << ", multi-scale " << num_hits_multi << std::endl;
+
+    std::cout << "latency [ms]   mean    median  p99     max" << std::endl;
+    std::cout << "full           " << latency_full.mean() << "\t" << latency_full.median() 
+              << "\t" << latency_full.percentile(99) << "\t" << latency_full.max() << std::endl;
+    std::cout << "multi-scale    " << latency_multi.mean() << "\t" << latency_multi.median() 
+              << "\t" << latency_multi.percentile(99) << "\t" << latency_multi.max() << std::endl;
+
+    std::cout << "pose error vs full resolution (mean, p99):" << std::endl;
+    std::cout << "translation [m]:  " << translation_error.mean() 
+              << ", " << translation_error.percentile(99) << std::endl;
+    std::cout << "rotation [deg]:   " << rotation_error.mean() 
+              << ", " << rotation_error.percentile(99) << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+// benchmark_pose_solvers.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include <iostream>
+
+#include "port/config.h"
+#include "system.h"
+#include "marker/aruco_detector.h"
+#include "marker/pose_solver.h"
+#include "util/statistics.h"
+
+using namespace tello_basic;
+
+
+/**
+ * latency and frame-to-frame jitter of each pose solver on recorded video.
+ * corners are detected once, then every solver runs on the same corners.
+ */
+int main(int argc, char **argv)
+{
+    // configure system =======================================================
+    std::string configuration_file_path = "./config/system_config.yaml";
+    
+    System::Ptr system = std::make_shared<System>(configuration_file_path);    
+    assert(system->initialize() == true);
+
+    ArUco_Detector::Ptr aruco_detector = system->get_aruco_detector();
+    aruco_detector->set_roi_tracking(false);
+    Camera::Ptr camera = system->get_mono_camera();
+
+    // detect target corners in every frame ===================================
+    std::string video_file_path = argc > 1 ? argv[1] : Config::read<std::string>("video_file_path");
+    cv::VideoCapture cap(video_file_path);
+    if (!cap.isOpened()) 
+    {
+        std::cerr << "ERROR: could not open " << video_file_path << std::endl;
+        return -1;
+    }
+
+    std::vector<std::vector<cv::Point2f>> p2Dss_normalized; // empty if missed
+    cv::Mat image, image_gray;
+    Detection_Result result;
+    while (cap.read(image) && !image.empty())
+    {
+        cv::cvtColor(image, image_gray, cv::COLOR_BGR2GRAY);
+        aruco_detector->process_frame(image_gray, Clock::now(), result);
+
+        std::vector<cv::Point2f> p2Ds_normalized;
+        if (result.target_found)
+        {
+            cv::undistortPoints(result.p2Dss_pixel[result.target_index], p2Ds_normalized, 
+                camera->cameraMatrix_, camera->distCoeffs_);
+        }
+        p2Dss_normalized.push_back(p2Ds_normalized);
+    }
+    std::cout << "frames: " << p2Dss_normalized.size() << std::endl;
+
+    // run solvers ============================================================
+    const std::vector<cv::Point3d>& p3Ds_target = aruco_detector->get_p3Ds_target();
+
+    std::cout << "solver               mean [us]  p99 [us]  jitter t [mm]  jitter R [deg]  flips" << std::endl;
+    for (const std::string solver_name : {"ippe_square", "iterative", "ippe_disambiguated"})
+    {
+        Pose_Solver::Ptr pose_solver = Pose_Solver::create(solver_name);
+
+        Pose_Prior prior;
+        Statistics latency;           // [us]
+        Statistics translation_step;  // [mm]
+        Statistics rotation_step;     // [deg]
+        int num_flips = 0;
+
+        for (std::vector<cv::Point2f>& p2Ds_normalized : p2Dss_normalized)
+        {
+            if (p2Ds_normalized.empty())
+            {
+                prior.valid = false;
+                continue;
+            }
+
+            cv::Mat p2Ds(4, 1, CV_32FC2, p2Ds_normalized.data());
+            cv::Vec3d rvec, tvec;
+
+            Timestamp t0 = Clock::now();
+            pose_solver->solve(p3Ds_target, p2Ds, prior.valid ? &prior : nullptr, rvec, tvec);
+            latency.add(std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+
+            // frame-to-frame change ==========================================
+            if (prior.valid)
+            {
+                translation_step.add(cv::norm(tvec - prior.tvec) * 1000);
+
+                cv::Matx33d R_prior, R;
+                cv::Rodrigues(prior.rvec, R_prior);
+                cv::Rodrigues(rvec, R);
+                cv::Vec3d rvec_step;
+                cv::Rodrigues(R_prior.t() * R, rvec_step);
+                double angle = cv::norm(rvec_step) * 180 / CV_PI;
+                rotation_step.add(angle);
+
+                if (angle > 30)
+                    ++num_flips; // ambiguous solution picked
+            }
+
+            prior.rvec = rvec;
+            prior.tvec = tvec;
+            prior.valid = true;
+        }
+
+        std::cout << solver_name << "\t     " << latency.mean() << "\t" 
+                  << latency.percentile(99) << "\t  " 
+                  << translation_step.standard_deviation() << "\t\t " 
+                  << rotation_step.standard_deviation() << "\t\t " 
+                  << num_flips << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+// benchmark_projection.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include <iostream>
+
+#include "port/config.h"
+#include "system.h"
+#include "camera/pinhole.h"
+#include "camera/brown_conrady.h"
+#include "util/statistics.h"
+
+using namespace tello_basic;
+
+
+/**
+ * batch project/unproject throughput per camera model, 
+ * against cv::projectPoints and cv::undistortPoints on same points
+ */
+template <typename Function>
+double measure_points_per_second(const Function& function, 
+    const long& num_points, const int& num_repetitions)
+{
+    Statistics latency; // [s]
+    for (int i = 0; i < num_repetitions; ++i)
+    {
+        Timestamp t0 = Clock::now();
+        function();
+        latency.add(std::chrono::duration<double>(Clock::now() - t0).count());
+    }
+
+    return num_points / latency.median();
+}
+
+int main(int argc, char **argv)
+{
+    // configure system =======================================================
+    std::string configuration_file_path = "./config/system_config.yaml";
+    
+    System::Ptr system = std::make_shared<System>(configuration_file_path);    
+    assert(system->initialize() == true);
+
+    // same intrinsics for every model ========================================
+    Camera::Ptr camera = system->get_mono_camera();
+    cv::Mat distCoeffs = camera->distCoeffs_.empty() ? 
+        cv::Mat::zeros(5, 1, CV_64FC1) : camera->distCoeffs_;
+
+    Camera::Ptr pinhole = std::make_shared<Pinhole>(
+        std::vector<cv::Mat>{camera->cameraMatrix_});
+    Camera::Ptr brown_conrady = std::make_shared<Brown_Conrady>(
+        std::vector<cv::Mat>{camera->cameraMatrix_, distCoeffs});
+
+    // random points in front of camera =======================================
+    long num_points = argc > 1 ? std::atol(argv[1]) : 100000;
+    int num_repetitions = 20;
+
+    MatX3 p3Ds_camera = MatX3::Random(num_points, 3);
+    p3Ds_camera.col(2).array() = p3Ds_camera.col(2).array().abs() + 1.5;
+
+    MatX2 p2Ds_pixel;
+    MatX3 p3Ds_normalized;
+
+    // OpenCV layout (array of structures)
+    std::vector<cv::Point3d> p3Ds_cv(num_points);
+    for (long i = 0; i < num_points; ++i)
+        p3Ds_cv[i] = cv::Point3d(p3Ds_camera(i, 0), p3Ds_camera(i, 1), p3Ds_camera(i, 2));
+    std::vector<cv::Point2d> p2Ds_cv, p2Ds_normalized_cv;
+    cv::Vec3d zero(0, 0, 0);
+
+    // measure ================================================================
+    std::cout << num_points << " points, median of " << num_repetitions << " runs" << std::endl;
+    std::cout << "model            project [Mpt/s]  unproject [Mpt/s]" << std::endl;
+
+    std::vector<std::pair<std::string, Camera::Ptr>> models = 
+        {{"pinhole", pinhole}, {"brown_conrady", brown_conrady}};
+    for (const std::pair<std::string, Camera::Ptr>& model : models)
+    {
+        const Camera::Ptr& model_camera = model.second;
+        model_camera->project(p3Ds_camera, p2Ds_pixel);
+
+        double project_rate = measure_points_per_second(
+            [&] {model_camera->project(p3Ds_camera, p2Ds_pixel);}, 
+            num_points, num_repetitions);
+        double unproject_rate = measure_points_per_second(
+            [&] {model_camera->unproject(p2Ds_pixel, p3Ds_normalized);}, 
+            num_points, num_repetitions);
+
+        std::cout << model.first << "\t\t " << project_rate / 1e6 
+                  << "\t\t  " << unproject_rate / 1e6 << std::endl;
+    }
+
+    cv::projectPoints(p3Ds_cv, zero, zero, camera->cameraMatrix_, distCoeffs, p2Ds_cv);
+    double project_rate = measure_points_per_second(
+        [&] {cv::projectPoints(p3Ds_cv, zero, zero, camera->cameraMatrix_, distCoeffs, p2Ds_cv);}, 
+        num_points, num_repetitions);
+    double unproject_rate = measure_points_per_second(
+        [&] {cv::undistortPoints(p2Ds_cv, p2Ds_normalized_cv, camera->cameraMatrix_, distCoeffs);}, 
+        num_points, num_repetitions);
+
+    std::cout << "OpenCV (B-C)\t " << project_rate / 1e6 
+              << "\t\t  " << unproject_rate / 1e6 << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,220 @@
+// benchmark_stages.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+
+#include "port/config.h"
+#include "system.h"
+#include "marker/aruco_detector.h"
+#include "util/statistics.h"
+
+using namespace tello_basic;
+
+
+/**
+ * per-stage latency of the serial loop over recorded videos, no window.
+ * usage: benchmark_stages [video ...]  (default: video_file_path)
+ * writes a table to stdout and bench_json_file (default bench_result.json),
+ * and poses to <bench_json_file>.poses.csv in the detector's layout (t_ms, rvec, tvec).
+ */
+static const std::vector<std::string> stage_names = 
+    {"decode", "grayscale", "detect", "pose", "draw", "log"};
+
+struct Video_Result
+{
+    std::string video_file_path;
+    long num_frames = 0;
+    long num_target_frames = 0;
+    double elapsed = 0; // [s]
+    std::vector<Statistics> latencies = std::vector<Statistics>(stage_names.size()); // [ms]
+};
+
+static double elapsed_ms(Timestamp& t)
+{
+    Timestamp now = Clock::now();
+    double ms = std::chrono::duration<double, std::milli>(now - t).count();
+    t = now;
+
+    return ms;
+}
+
+// ----------------------------------------------------------------------------
+static bool run_video(ArUco_Detector::Ptr aruco_detector, 
+    std::ofstream& pose_stream, Video_Result& video_result)
+{
+    cv::VideoCapture cap(video_result.video_file_path);
+    if (!cap.isOpened())
+    {
+        std::cerr << "ERROR: could not open " << video_result.video_file_path << std::endl;
+        return false;
+    }
+
+    aruco_detector->reset_tracking();
+
+    cv::Mat image, image_gray;
+    Detection_Result result;
+    result.reserve(16);
+
+    std::vector<Statistics>& latencies = video_result.latencies;
+    Timestamp t_start = Clock::now();
+    for (;;)
+    {
+        Timestamp t = Clock::now();
+        if (!cap.read(image) || image.empty())
+            break;
+        latencies[0].add(elapsed_ms(t));
+
+        // same clock as detector's csv (Frame::t_ms)
+        long t_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        cv::cvtColor(image, image_gray, cv::COLOR_BGR2GRAY);
+        latencies[1].add(elapsed_ms(t));
+
+        aruco_detector->detect_frame(image_gray, t, result);
+        latencies[2].add(elapsed_ms(t));
+
+        aruco_detector->estimate_pose_frame(result);
+        latencies[3].add(elapsed_ms(t));
+
+        aruco_detector->draw(image_gray, result);
+        latencies[4].add(elapsed_ms(t));
+
+        aruco_detector->write_pose(pose_stream, t_ms, result);
+        latencies[5].add(elapsed_ms(t));
+
+        ++video_result.num_frames;
+        if (result.target_found)
+            ++video_result.num_target_frames;
+    }
+    video_result.elapsed = std::chrono::duration<double>(Clock::now() - t_start).count();
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+static void print_table(Video_Result& video_result)
+{
+    std::cout << std::endl << video_result.video_file_path << std::endl;
+    std::cout << "frames: " << video_result.num_frames 
+              << ", target found: " << video_result.num_target_frames 
+              << ", FPS: " << video_result.num_frames / video_result.elapsed << std::endl;
+
+    std::cout << std::left << std::setw(12) << "stage [ms]" << std::right 
+              << std::setw(10) << "min" << std::setw(10) << "median" 
+              << std::setw(10) << "p99" << std::setw(10) << "max" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < stage_names.size(); ++i)
+    {
+        Statistics& latency = video_result.latencies[i];
+        std::cout << std::left << std::setw(12) << stage_names[i] << std::right 
+                  << std::setw(10) << latency.min() << std::setw(10) << latency.median() 
+                  << std::setw(10) << latency.percentile(99) << std::setw(10) << latency.max() 
+                  << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
+
+// ----------------------------------------------------------------------------
+static std::string escape_json(const std::string& text)
+{
+    std::ostringstream stream;
+    for (const char& c : text)
+    {
+        if (c == '"' || c == '\\')
+            stream << '\\' << c;
+        else if ((unsigned char)c < 0x20)
+            stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c;
+        else
+            stream << c;
+    }
+
+    return stream.str();
+}
+
+// ----------------------------------------------------------------------------
+static void write_json(std::ofstream& stream, std::vector<Video_Result>& video_results)
+{
+    stream << "{\n  \"videos\": [\n";
+    for (size_t v = 0; v < video_results.size(); ++v)
+    {
+        Video_Result& video_result = video_results[v];
+        stream << "    {\n"
+               << "      \"video\": \"" << escape_json(video_result.video_file_path) << "\",\n"
+               << "      \"frames\": " << video_result.num_frames << ",\n"
+               << "      \"target_frames\": " << video_result.num_target_frames << ",\n"
+               << "      \"fps\": " << video_result.num_frames / video_result.elapsed << ",\n"
+               << "      \"stages_ms\": {\n";
+        for (size_t i = 0; i < stage_names.size(); ++i)
+        {
+            Statistics& latency = video_result.latencies[i];
+            stream << "        \"" << stage_names[i] << "\": {" 
+                   << "\"min\": " << latency.min() << ", "
+                   << "\"median\": " << latency.median() << ", "
+                   << "\"p99\": " << latency.percentile(99) << ", "
+                   << "\"max\": " << latency.max() << "}"
+                   << (i + 1 < stage_names.size() ? "," : "") << "\n";
+        }
+        stream << "      }\n    }" << (v + 1 < video_results.size() ? "," : "") << "\n";
+    }
+    stream << "  ]\n}\n";
+}
+
+// ----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    // configure system =======================================================
+    std::string configuration_file_path = "./config/system_config.yaml";
+    
+    System::Ptr system = std::make_shared<System>(configuration_file_path);    
+    assert(system->initialize() == true);
+
+    ArUco_Detector::Ptr aruco_detector = system->get_aruco_detector();
+    aruco_detector->set_headless(true);
+    aruco_detector->set_verbose(false);
+
+    std::vector<Video_Result> video_results;
+    for (int i = 1; i < argc; ++i)
+    {
+        video_results.emplace_back();
+        video_results.back().video_file_path = argv[i];
+    }
+    if (video_results.empty())
+    {
+        video_results.emplace_back();
+        video_results.back().video_file_path = Config::read<std::string>("video_file_path");
+    }
+
+    std::string json_file_path = Config::read<std::string>("bench_json_file");
+    if (json_file_path.empty())
+        json_file_path = "bench_result.json";
+
+    // run ====================================================================
+    std::ofstream pose_stream(json_file_path + ".poses.csv");
+    for (Video_Result& video_result : video_results)
+    {
+        if (!run_video(aruco_detector, pose_stream, video_result))
+            return -1;
+
+        print_table(video_result);
+    }
+
+    std::ofstream json_stream(json_file_path);
+    write_json(json_stream, video_results);
+    std::cout << std::endl << "written " << json_file_path << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+// benchmark_synthetic.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include <iostream>
+#include <iomanip>
+
+#include "port/config.h"
+#include "system.h"
+#include "marker/aruco_detector.h"
+#include "marker/scene_generator.h"
+#include "util/statistics.h"
+
+using namespace tello_basic;
+
+
+/**
+ * pose accuracy and throughput on an in-memory synthetic stream, no camera.
+ * optional thresholds make it fail (exit 1) on regression:
+ *   synthetic_min_detection_rate, synthetic_max_translation_error [m],
+ *   synthetic_max_rotation_error [deg] (all on median, 0 to disable)
+ */
+static void print_row(const std::string& name, Statistics& statistics)
+{
+    std::cout << std::left << std::setw(24) << name << std::right 
+              << std::setw(10) << statistics.median() 
+              << std::setw(10) << statistics.percentile(99) 
+              << std::setw(10) << statistics.max() << std::endl;
+}
+
+// ----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    // configure system =======================================================
+    std::string configuration_file_path = "./config/system_config.yaml";
+    
+    System::Ptr system = std::make_shared<System>(configuration_file_path);    
+    assert(system->initialize() == true);
+
+    ArUco_Detector::Ptr aruco_detector = system->get_aruco_detector();
+    aruco_detector->set_headless(true);
+    aruco_detector->set_verbose(false);
+    Camera::Ptr camera = system->get_mono_camera();
+
+    Scene_Options options;
+    if (!camera->get_image_size().empty())
+        options.image_size = camera->get_image_size();
+    options.read_config();
+
+    int num_frames = Config::read<int>("synthetic_num_frames");
+    num_frames = num_frames > 0 ? num_frames : 300;
+
+    int target_id = aruco_detector->get_target_id();
+    Scene_Generator scene_generator(camera, aruco_detector->get_dictionary(), 
+        aruco_detector->get_marker_length(), {target_id}, options);
+
+    // run ====================================================================
+    Synthetic_Frame frame;
+    cv::Mat image_gray;
+    Detection_Result result;
+    result.reserve(16);
+
+    Statistics translation_errors, rotation_errors, corner_errors; // [m], [deg], [pixel]
+    Statistics latencies; // [ms]
+    int num_detected = 0;
+
+    aruco_detector->reset_tracking();
+    for (int i = 0; i < num_frames; ++i)
+    {
+        scene_generator.next_frame(frame);
+        cv::cvtColor(frame.image, image_gray, cv::COLOR_BGR2GRAY);
+
+        Timestamp t = Clock::now();
+        aruco_detector->track_frame(image_gray, frame.timestamp, result);
+        latencies.add(std::chrono::duration<double, std::milli>(Clock::now() - t).count());
+
+        if (!result.target_found || !result.pose.valid)
+            continue;
+        ++num_detected;
+
+        // pose error against ground truth -----------------------------------
+        const Marker_Pose& truth = frame.poses[0];
+        translation_errors.add((result.pose.t_cm - truth.t_cm).norm());
+        rotation_errors.add(result.pose.q_cm.angularDistance(truth.q_cm) * 180 / CV_PI);
+
+        const std::vector<cv::Point2f>& p2Ds_truth = frame.p2Dss_pixel[0];
+        const std::vector<cv::Point2f>& p2Ds = result.p2Dss_pixel[result.target_index];
+        double corner_error = 0;
+        for (size_t j = 0; j < p2Ds_truth.size(); ++j)
+            corner_error += cv::norm(p2Ds[j] - p2Ds_truth[j]) / p2Ds_truth.size();
+        corner_errors.add(corner_error);
+    }
+
+    // report =================================================================
+    double detection_rate = (double)num_detected / num_frames;
+
+    std::cout << "frames: " << num_frames << " (" << options.image_size << ")"
+              << ", detection rate: " << detection_rate 
+              << ", FPS: " << 1000 / std::max(latencies.mean(), 1e-9) << std::endl;
+    std::cout << std::left << std::setw(24) << "" << std::right 
+              << std::setw(10) << "median" << std::setw(10) << "p99" 
+              << std::setw(10) << "max" << std::endl;
+    std::cout << std::fixed << std::setprecision(4);
+    print_row("latency [ms]", latencies);
+    print_row("translation error [m]", translation_errors);
+    print_row("rotation error [deg]", rotation_errors);
+    print_row("corner error [pixel]", corner_errors);
+    std::cout << std::defaultfloat;
+
+    // regression thresholds ==================================================
+    double min_detection_rate = Config::read<double>("synthetic_min_detection_rate");
+    double max_translation_error = Config::read<double>("synthetic_max_translation_error");
+    double max_rotation_error = Config::read<double>("synthetic_max_rotation_error");
+
+    bool passed = true;
+    if (min_detection_rate > 0 && detection_rate < min_detection_rate)
+    {
+        std::cerr << "ERROR: detection rate below " << min_detection_rate << std::endl;
+        passed = false;
+    }
+    if (max_translation_error > 0 && translation_errors.median() > max_translation_error)
+    {
+        std::cerr << "ERROR: translation error above " << max_translation_error << " m" << std::endl;
+        passed = false;
+    }
+    if (max_rotation_error > 0 && rotation_errors.median() > max_rotation_error)
+    {
+        std::cerr << "ERROR: rotation error above " << max_rotation_error << " deg" << std::endl;
+        passed = false;
+    }
+
+    return passed ? 0 : 1;
+}
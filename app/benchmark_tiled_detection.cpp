@@ -0,0 +1,118 @@
+// benchmark_tiled_detection.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include <iostream>
+
+#include "port/config.h"
+#include "system.h"
+#include "marker/aruco_detector.h"
+#include "util/statistics.h"
+
+using namespace tello_basic;
+
+
+/**
+ * scaling of tiled parallel detection at 1/2/4/8 threads.
+ * usage: benchmark_tiled_detection [video ...]
+ * each video is run at native size (e.g. 960x720 Tello) and upscaled to 1920x1080.
+ * every frame runs a full-frame detection with wide default parameters,
+ * tracked state is reset between thread counts, so all columns do the same work.
+ */
+int main(int argc, char **argv)
+{
+    // configure system =======================================================
+    std::string configuration_file_path = "./config/system_config.yaml";
+    
+    System::Ptr system = std::make_shared<System>(configuration_file_path);    
+    assert(system->initialize() == true);
+
+    ArUco_Detector::Ptr aruco_detector = system->get_aruco_detector();
+    aruco_detector->set_roi_tracking(false);
+    aruco_detector->set_multi_scale(false);
+    aruco_detector->set_corner_tracking(false);
+    aruco_detector->set_adaptive_parameters(false);
+
+    std::vector<std::string> video_file_paths;
+    for (int i = 1; i < argc; ++i)
+        video_file_paths.push_back(argv[i]);
+    if (video_file_paths.empty())
+        video_file_paths.push_back(Config::read<std::string>("video_file_path"));
+
+    const int max_num_frames = 300;
+    const std::vector<int> nums_threads = {1, 2, 4, 8};
+
+    for (const std::string& video_file_path : video_file_paths)
+    {
+        // load frames once, so decoding is not measured =====================
+        cv::VideoCapture cap(video_file_path);
+        if (!cap.isOpened()) 
+        {
+            std::cerr << "ERROR: could not open " << video_file_path << std::endl;
+            continue;
+        }
+
+        std::vector<cv::Mat> images_native, images_upscaled;
+        cv::Mat image, image_gray;
+        while ((int)images_native.size() < max_num_frames && cap.read(image) && !image.empty())
+        {
+            cv::cvtColor(image, image_gray, cv::COLOR_BGR2GRAY);
+            images_native.push_back(image_gray.clone());
+
+            cv::Mat image_upscaled;
+            cv::resize(image_gray, image_upscaled, cv::Size(1920, 1080), 0, 0, cv::INTER_LINEAR);
+            images_upscaled.push_back(image_upscaled);
+        }
+
+        for (const std::vector<cv::Mat>* images : {&images_native, &images_upscaled})
+        {
+            if (images->empty())
+                continue;
+
+            std::cout << video_file_path << " " << images->front().cols 
+                      << "x" << images->front().rows 
+                      << (images == &images_upscaled ? " (upscaled)" : " (native)")
+                      << ", " << images->size() << " frames" << std::endl;
+            std::cout << "threads  median [ms]  p99 [ms]  FPS      speedup  markers" << std::endl;
+
+            double fps_1_thread = 0;
+            for (const int& num_threads : nums_threads)
+            {
+                aruco_detector->set_detection_threads(num_threads);
+                aruco_detector->reset_tracking(); // no pose priors from previous run
+
+                Detection_Result result;
+                Statistics latency; // [ms]
+                long num_markers = 0;
+
+                Timestamp t_start = Clock::now();
+                for (const cv::Mat& image_gray : *images)
+                {
+                    Timestamp t0 = Clock::now();
+                    aruco_detector->track_frame(image_gray, t0, result);
+                    latency.add(std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+                    num_markers += result.ids.size();
+                }
+                double elapsed = std::chrono::duration<double>(Clock::now() - t_start).count();
+                double fps = images->size() / elapsed;
+                if (num_threads == 1)
+                    fps_1_thread = fps;
+
+                std::cout << num_threads << "\t " << latency.median() << "\t      " 
+                          << latency.percentile(99) << "\t" << fps << "\t " 
+                          << fps / fps_1_thread << "\t  " << num_markers << std::endl;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+// benchmark_undistortion.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include <iostream>
+#include <random>
+
+#include "port/config.h"
+#include "system.h"
+#include "util/statistics.h"
+
+using namespace tello_basic;
+
+
+/**
+ * latency and accuracy of table lookup undistortion against OpenCV.
+ * reference is cv::undistortPoints (cv::fisheye for Kannala-Brandt)
+ * run to convergence.
+ */
+int main(int argc, char **argv)
+{
+    // configure system =======================================================
+    std::string configuration_file_path = "./config/system_config.yaml";
+    
+    System::Ptr system = std::make_shared<System>(configuration_file_path);    
+    assert(system->initialize() == true);
+
+    Camera::Ptr camera = system->get_mono_camera();
+    cv::Size image_size = camera->get_image_size();
+    std::cout << "image size: " << image_size << std::endl;
+
+    int num_trials = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const int num_points = 64; // 16 markers
+
+    // random corners =========================================================
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> u(0, image_size.width - 1);
+    std::uniform_real_distribution<float> v(0, image_size.height - 1);
+
+    std::vector<cv::Point2f> p2Ds_pixel(num_points);
+    std::vector<cv::Point2f> p2Ds_lut, p2Ds_opencv, p2Ds_reference;
+
+    Statistics latency_lut, latency_opencv; // [us]
+    Statistics error_lut, error_opencv;     // [pixel]
+
+    cv::TermCriteria converged(cv::TermCriteria::COUNT | cv::TermCriteria::EPS, 100, 1e-12);
+
+    for (int trial = 0; trial < num_trials; ++trial)
+    {
+        for (cv::Point2f& p2D_pixel : p2Ds_pixel)
+            p2D_pixel = cv::Point2f(u(generator), v(generator));
+
+        Timestamp t0 = Clock::now();
+        camera->undistort_points(p2Ds_pixel, p2Ds_lut);
+        Timestamp t1 = Clock::now();
+        if (camera->camera_model_ == Camera::KANNALA_BRANDT)
+            cv::fisheye::undistortPoints(p2Ds_pixel, p2Ds_opencv, camera->cameraMatrix_, camera->distCoeffs_);
+        else
+            cv::undistortPoints(p2Ds_pixel, p2Ds_opencv, camera->cameraMatrix_, camera->distCoeffs_);
+        Timestamp t2 = Clock::now();
+
+        latency_lut.add(std::chrono::duration<double, std::micro>(t1 - t0).count());
+        latency_opencv.add(std::chrono::duration<double, std::micro>(t2 - t1).count());
+
+        // accuracy, in pixels at focal length ================================
+        if (camera->camera_model_ == Camera::KANNALA_BRANDT)
+        {
+            cv::fisheye::undistortPoints(p2Ds_pixel, p2Ds_reference, camera->cameraMatrix_, camera->distCoeffs_, 
+                cv::noArray(), cv::noArray(), converged);
+        }
+        else
+        {
+            cv::undistortPoints(p2Ds_pixel, p2Ds_reference, camera->cameraMatrix_, camera->distCoeffs_, 
+                cv::noArray(), cv::noArray(), converged);
+        }
+        for (int i = 0; i < num_points; ++i)
+        {
+            error_lut.add(cv::norm(p2Ds_lut[i] - p2Ds_reference[i]) * camera->fx_);
+            error_opencv.add(cv::norm(p2Ds_opencv[i] - p2Ds_reference[i]) * camera->fx_);
+        }
+    }
+
+    std::cout << num_points << " points per call, " << num_trials << " calls" << std::endl;
+    std::cout << "method               mean [us]  p99 [us]  mean error [px]  max error [px]" << std::endl;
+    std::cout << "lookup table\t     " << latency_lut.mean() << "\t" 
+              << latency_lut.percentile(99) << "\t  " 
+              << error_lut.mean() << "\t\t   " << error_lut.max() << std::endl;
+    std::cout << "cv::undistortPoints  " << latency_opencv.mean() << "\t" 
+              << latency_opencv.percentile(99) << "\t  " 
+              << error_opencv.mean() << "\t\t   " << error_opencv.max() << std::endl;
+
+    // display rectification ==================================================
+    cv::Mat image(image_size, CV_8UC1), image_rectified;
+    cv::randu(image, 0, 255);
+
+    Statistics latency_remap, latency_undistort; // [ms]
+    for (int trial = 0; trial < 100; ++trial)
+    {
+        Timestamp t0 = Clock::now();
+        camera->rectify(image, image_rectified);
+        Timestamp t1 = Clock::now();
+        cv::undistort(image, image_rectified, camera->cameraMatrix_, camera->distCoeffs_);
+        Timestamp t2 = Clock::now();
+
+        latency_remap.add(std::chrono::duration<double, std::milli>(t1 - t0).count());
+        latency_undistort.add(std::chrono::duration<double, std::milli>(t2 - t1).count());
+    }
+
+    std::cout << "rectify (cached map) mean [ms]: " << latency_remap.mean() << std::endl;
+    std::cout << "cv::undistort        mean [ms]: " << latency_undistort.mean() << std::endl;
+
+    return 0;
+}
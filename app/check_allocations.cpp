@@ -0,0 +1,387 @@
+// check_allocations.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <functional>
+#include <algorithm>
+
+#include "port/config.h"
+#include "system.h"
+#include "marker/aruco_detector.h"
+#include "marker/scene_generator.h"
+#include "util/statistics.h"
+
+using namespace tello_basic;
+
+
+/**
+ * heap allocations per frame on the steady-state tracking path.
+ * usage: check_allocations [video]
+ * runs track_frame over warm-up frames, then counts allocations of the
+ * measured frames. frames come from the video, else from the synthetic
+ * scene (synthetic_* keys).
+ *
+ * counted: global operator new, i.e. std containers, cv::AutoBuffer and
+ * every cv::Mat buffer (its UMatData is new'ed by the default allocator).
+ * not counted: plain malloc, e.g. Eigen dynamic matrices.
+ *
+ * exits 1 if a part this repo controls allocates: estimate_pose_frame,
+ * Camera::undistort_points, Camera::project, or the Detection_Result
+ * buffers growing. detect_frame runs OpenCV (detectMarkers, or the
+ * optical flow of corner tracking), which allocates internally; its
+ * counts are reported per kind of frame and only fail against the
+ * optional baselines allocation_baseline_detected / _tracked
+ * (max allocations per frame, unset: report only).
+ *
+ * afterwards, the calls the path is made of are counted one by one,
+ * to show which of them still allocate.
+ */
+
+// counting operator new ======================================================
+static std::atomic<bool> counting(false);
+static std::atomic<long> num_allocations(0);
+
+void* operator new(std::size_t size)
+{
+    if (counting.load(std::memory_order_relaxed))
+        num_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    void* p = std::malloc(size > 0 ? size : 1);
+    if (p == nullptr)
+        throw std::bad_alloc();
+
+    return p;
+}
+
+void* operator new[](std::size_t size) {return operator new(size);}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (counting.load(std::memory_order_relaxed))
+        num_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    // aligned_alloc needs size to be a multiple of alignment
+    std::size_t a = static_cast<std::size_t>(alignment);
+    void* p = std::aligned_alloc(a, (std::max(size, (std::size_t)1) + a - 1) / a * a);
+    if (p == nullptr)
+        throw std::bad_alloc();
+
+    return p;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {return operator new(size, alignment);}
+
+void operator delete(void* p) noexcept {std::free(p);}
+void operator delete[](void* p) noexcept {std::free(p);}
+void operator delete(void* p, std::size_t) noexcept {std::free(p);}
+void operator delete[](void* p, std::size_t) noexcept {std::free(p);}
+void operator delete(void* p, std::align_val_t) noexcept {std::free(p);}
+void operator delete[](void* p, std::align_val_t) noexcept {std::free(p);}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {std::free(p);}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {std::free(p);}
+
+/**
+ * @return allocations made by function, on any thread
+ */
+static long count_allocations(const std::function<void()>& function)
+{
+    num_allocations = 0;
+    counting = true;
+    function();
+    counting = false;
+
+    return num_allocations;
+}
+
+static void print_row(const std::string& name, Statistics& statistics)
+{
+    std::cout << std::left << std::setw(44) << name << std::right
+              << std::setw(10) << statistics.mean()
+              << std::setw(10) << statistics.max() << std::endl;
+}
+
+/**
+ * outer capacities of result buffers, changes when they reallocate
+ */
+static std::vector<size_t> get_capacities(const Detection_Result& result)
+{
+    return {result.ids.capacity(), result.p2Dss_pixel.capacity(),
+        result.target_indices.capacity(), result.rvecs.capacity(), 
+        result.tvecs.capacity(), result.poses.capacity(),
+        result.p2Ds_pixel_batch.capacity(), result.p2Ds_normalized_batch.capacity()};
+}
+
+/**
+ * @return false if a baseline is set and the frames' max exceeds it
+ */
+static bool check_baseline(const std::string& name, Statistics& statistics, 
+    const int& baseline)
+{
+    if (baseline < 0 || statistics.empty() || statistics.max() <= baseline)
+        return true;
+
+    std::cerr << "ERROR: " << name << " allocated up to " << statistics.max()
+              << " per frame, baseline " << baseline << std::endl;
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    // configure system =======================================================
+    std::string configuration_file_path = "./config/system_config.yaml";
+
+    System::Ptr system = std::make_shared<System>(configuration_file_path);
+    assert(system->initialize() == true);
+
+    ArUco_Detector::Ptr aruco_detector = system->get_aruco_detector();
+    aruco_detector->set_headless(true);
+    aruco_detector->set_verbose(false);
+    Camera::Ptr camera = system->get_mono_camera();
+
+    int max_num_markers = Config::read<int>("max_num_markers");
+    max_num_markers = max_num_markers > 0 ? max_num_markers : 16;
+
+    // known allocations of OpenCV per frame, -1: report only
+    int baseline_detected = Config::read<int>("allocation_baseline_detected");
+    baseline_detected = baseline_detected > 0 ? baseline_detected : -1;
+    int baseline_tracked = Config::read<int>("allocation_baseline_tracked");
+    baseline_tracked = baseline_tracked > 0 ? baseline_tracked : -1;
+
+    const int num_warm_up_frames = 30;
+    const int num_measured_frames = 200;
+
+    // load frames before counting ============================================
+    std::vector<cv::Mat> images;
+    cv::Mat image, image_gray;
+    if (argc > 1)
+    {
+        cv::VideoCapture cap(argv[1]);
+        if (!cap.isOpened())
+        {
+            std::cerr << "ERROR: could not open " << argv[1] << std::endl;
+            return 1;
+        }
+
+        while ((int)images.size() < num_warm_up_frames + num_measured_frames &&
+            cap.read(image) && !image.empty())
+        {
+            cv::cvtColor(image, image_gray, cv::COLOR_BGR2GRAY);
+            images.push_back(image_gray.clone());
+        }
+    }
+    else
+    {
+        Scene_Options options;
+        if (!camera->get_image_size().empty())
+            options.image_size = camera->get_image_size();
+        options.read_config();
+
+        Scene_Generator scene_generator(camera, aruco_detector->get_dictionary(),
+            aruco_detector->get_marker_length(), {aruco_detector->get_target_id()}, options);
+
+        Synthetic_Frame frame;
+        for (int i = 0; i < num_warm_up_frames + num_measured_frames; ++i)
+        {
+            scene_generator.next_frame(frame);
+            cv::cvtColor(frame.image, image_gray, cv::COLOR_BGR2GRAY);
+            images.push_back(image_gray.clone());
+        }
+    }
+
+    if ((int)images.size() <= num_warm_up_frames)
+    {
+        std::cerr << "ERROR: need more than " << num_warm_up_frames << " frames" << std::endl;
+        return 1;
+    }
+
+    // frame timestamps at 30 FPS, so ROI prediction and priors behave as live
+    Timestamp t0 = Clock::now();
+    auto get_timestamp = [&t0](const size_t& i)
+    {
+        return t0 + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(i / 30.0));
+    };
+
+    // tracking path ==========================================================
+    Detection_Result result;
+    result.reserve(max_num_markers);
+
+    aruco_detector->reset_tracking();
+    for (int i = 0; i < num_warm_up_frames; ++i)
+        aruco_detector->track_frame(images[i], get_timestamp(i), result);
+
+    std::vector<size_t> capacities = get_capacities(result);
+
+    Statistics detected_allocations, tracked_allocations, pose_allocations;
+    long num_allocating_pose_frames = 0;
+    for (size_t i = num_warm_up_frames; i < images.size(); ++i)
+    {
+        long num_detect = count_allocations([&]()
+        {
+            aruco_detector->detect_frame(images[i], get_timestamp(i), result);
+        });
+        long num_pose = count_allocations([&]()
+        {
+            aruco_detector->estimate_pose_frame(result);
+        });
+
+        if (result.tracked)
+            tracked_allocations.add(num_detect);
+        else
+            detected_allocations.add(num_detect);
+        pose_allocations.add(num_pose);
+        if (num_pose > 0)
+            ++num_allocating_pose_frames;
+    }
+
+    bool buffers_grown = get_capacities(result) != capacities;
+
+    // calls of the path one by one, same frames ==============================
+    cv::aruco::ArucoDetector detector(aruco_detector->get_dictionary());
+    std::vector<int> ids;
+    std::vector<std::vector<cv::Point2f>> p2Dss_pixel;
+    ids.reserve(max_num_markers);
+    p2Dss_pixel.reserve(max_num_markers);
+
+    std::vector<cv::Mat> pyramid_previous, pyramid_current;
+    std::vector<cv::Point2f> p2Ds_previous, p2Ds_current;
+    std::vector<unsigned char> status;
+    std::vector<float> errors;
+    cv::Size window_size(21, 21);
+
+    std::vector<cv::Point2f> p2Ds_normalized;
+    std::string pose_solver_name = Config::read<std::string>("pose_solver");
+    Pose_Solver::Ptr pose_solver = Pose_Solver::create(pose_solver_name);
+    if (pose_solver == nullptr)
+    {
+        pose_solver_name = "ippe_square";
+        pose_solver = Pose_Solver::create(pose_solver_name);
+    }
+    cv::Vec3d rvec, tvec;
+    MatX3 p3Ds_camera = MatX3::Zero(4, 3);
+    p3Ds_camera.col(2).setConstant(1);
+    MatX2 p2Ds_projected(4, 2);
+
+    Statistics detect_markers_allocations, pyramid_allocations, optical_flow_allocations;
+    Statistics undistort_allocations, solve_allocations, project_allocations;
+    for (size_t i = 0; i < images.size(); ++i)
+    {
+        bool measured = (int)i >= num_warm_up_frames;
+
+        long num_detect_markers = count_allocations([&]()
+        {
+            detector.detectMarkers(images[i], p2Dss_pixel, ids);
+        });
+        long num_pyramid = count_allocations([&]()
+        {
+            cv::buildOpticalFlowPyramid(images[i], pyramid_current, window_size, 3);
+        });
+        if (measured)
+        {
+            detect_markers_allocations.add(num_detect_markers);
+            pyramid_allocations.add(num_pyramid);
+        }
+
+        // follow first marker of previous frame
+        if (!p2Ds_previous.empty())
+        {
+            long num_optical_flow = count_allocations([&]()
+            {
+                cv::calcOpticalFlowPyrLK(pyramid_previous, pyramid_current,
+                    p2Ds_previous, p2Ds_current, status, errors, window_size, 3);
+            });
+            if (measured)
+                optical_flow_allocations.add(num_optical_flow);
+        }
+        std::swap(pyramid_previous, pyramid_current);
+        p2Ds_previous.clear();
+
+        if (ids.empty())
+            continue;
+        p2Ds_previous.insert(p2Ds_previous.end(), p2Dss_pixel[0].begin(), p2Dss_pixel[0].end());
+
+        long num_undistort = count_allocations([&]()
+        {
+            camera->undistort_points(p2Dss_pixel[0], p2Ds_normalized);
+        });
+        cv::Mat p2Ds_normalized_header(4, 1, CV_32FC2, p2Ds_normalized.data());
+        long num_solve = count_allocations([&]()
+        {
+            pose_solver->solve(aruco_detector->get_p3Ds_target(),
+                p2Ds_normalized_header, nullptr, rvec, tvec);
+        });
+        long num_project = count_allocations([&]()
+        {
+            camera->project(p3Ds_camera, p2Ds_projected);
+        });
+
+        if (measured)
+        {
+            undistort_allocations.add(num_undistort);
+            solve_allocations.add(num_solve);
+            project_allocations.add(num_project);
+        }
+    }
+
+    // report =================================================================
+    std::cout << "frames: " << num_warm_up_frames << " warm-up, "
+              << images.size() - num_warm_up_frames << " measured ("
+              << images.front().cols << "x" << images.front().rows << ")" << std::endl;
+    std::cout << std::left << std::setw(44) << "allocations per frame" << std::right
+              << std::setw(10) << "mean" << std::setw(10) << "max" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    print_row("track_frame: detect_frame, detected (" + 
+        std::to_string(detected_allocations.size()) + ")", detected_allocations);
+    print_row("track_frame: detect_frame, tracked (" + 
+        std::to_string(tracked_allocations.size()) + ")", tracked_allocations);
+    print_row("track_frame: estimate_pose_frame", pose_allocations);
+    std::cout << "calls of the path:" << std::endl;
+    print_row("  cv::aruco::ArucoDetector::detectMarkers", detect_markers_allocations);
+    print_row("  cv::buildOpticalFlowPyramid", pyramid_allocations);
+    print_row("  cv::calcOpticalFlowPyrLK", optical_flow_allocations);
+    print_row("  Camera::undistort_points", undistort_allocations);
+    print_row("  Pose_Solver::solve (" + pose_solver_name + ")", solve_allocations);
+    print_row("  Camera::project", project_allocations);
+    std::cout << std::defaultfloat;
+
+    // repo-controlled parts must not allocate ================================
+    bool passed = true;
+    if (num_allocating_pose_frames > 0)
+    {
+        std::cerr << "ERROR: estimate_pose_frame allocated in " << num_allocating_pose_frames 
+                  << " of " << images.size() - num_warm_up_frames 
+                  << " measured frames" << std::endl;
+        passed = false;
+    }
+    if (undistort_allocations.max() > 0 || project_allocations.max() > 0)
+    {
+        std::cerr << "ERROR: Camera::undistort_points or Camera::project allocated" << std::endl;
+        passed = false;
+    }
+    if (buffers_grown)
+    {
+        std::cerr << "ERROR: Detection_Result buffers grew, raise max_num_markers" << std::endl;
+        passed = false;
+    }
+
+    // OpenCV inside detect_frame, against known counts =======================
+    passed &= check_baseline("detect_frame, detected", detected_allocations, baseline_detected);
+    passed &= check_baseline("detect_frame, tracked", tracked_allocations, baseline_tracked);
+
+    return passed ? 0 : 1;
+}
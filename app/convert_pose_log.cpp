@@ -0,0 +1,66 @@
+// convert_pose_log.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include <iostream>
+#include <fstream>
+
+#include "port/pose_logger.h"
+
+using namespace tello_basic;
+
+
+/**
+ * convert binary pose log (pose_log_format: binary) to the csv layout
+ * written by data collection (t, rvec, tvec).
+ * usage: convert_pose_log <log.bin> [out.csv]  (default: log.bin minus .bin)
+ */
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: convert_pose_log <log.bin> [out.csv]" << std::endl;
+        return -1;
+    }
+
+    std::string log_file_path = argv[1];
+    std::string csv_file_path = argc > 2 ? argv[2] : log_file_path + ".csv";
+    const std::string extension = ".bin";
+    if (argc <= 2 && log_file_path.size() > extension.size() && 
+        log_file_path.compare(log_file_path.size() - extension.size(), extension.size(), extension) == 0)
+    {
+        csv_file_path = log_file_path.substr(0, log_file_path.size() - extension.size());
+    }
+
+    std::vector<Pose_Record> records;
+    if (!Pose_Logger::read(log_file_path, records))
+        return -1;
+
+    std::ofstream stream(csv_file_path);
+    if (!stream.is_open())
+    {
+        std::cerr << "ERROR: could not open " << csv_file_path << std::endl;
+        return -1;
+    }
+
+    // same formatting as ArUco_Detector::write_pose
+    for (const Pose_Record& record : records)
+    {
+        stream << record.t_ms << ',' << 
+            record.rvec[0] << ',' << record.rvec[1] << ',' << record.rvec[2] << ',' <<
+            record.tvec[0] << ',' << record.tvec[1] << ',' << record.tvec[2] << '\n';
+    }
+
+    std::cout << "written " << records.size() << " poses to " << csv_file_path << std::endl;
+
+    return 0;
+}
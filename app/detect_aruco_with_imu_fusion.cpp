@@ -0,0 +1,116 @@
+// detect_aruco_with_imu_fusion.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include <iostream>
+
+#include "port/config.h"
+#include "system.h"
+#include "marker/aruco_detector.h"
+#include "estimation/pose_filter.h"
+#include "tello.hpp"
+
+using namespace tello_basic;
+
+
+int main(int argc, char **argv)
+{
+    // configure system =======================================================
+    std::string configuration_file_path = "./config/system_config.yaml";
+    
+    System::Ptr system = std::make_shared<System>(configuration_file_path);    
+    assert(system->initialize() == true);
+
+    Pose_Filter::Ptr pose_filter = system->get_pose_filter();
+    if (!pose_filter)
+    {
+        std::cout << "ERROR: pose_filter is disabled in configuration" << std::endl;
+        return -1;
+    }
+
+    double output_rate = Config::read<double>("pose_filter_output_rate");
+    output_rate = output_rate > 0 ? output_rate : 100;
+    double imu_rate = Config::read<double>("tello_state_rate");
+    imu_rate = imu_rate > 0 ? imu_rate : 50;
+
+    // Tello units: velocity [dm/s], acceleration [mg]
+    double velocity_scale = Config::read<double>("tello_velocity_scale");
+    velocity_scale = velocity_scale > 0 ? velocity_scale : 0.1;
+    double acceleration_scale = Config::read<double>("tello_acceleration_scale");
+    acceleration_scale = acceleration_scale > 0 ? acceleration_scale : 0.00981;
+
+    // connect to Tello =======================================================
+    Tello tello;
+    if (!tello.connect()) 
+    {
+        return -1;
+    }
+
+    tello.enable_video_stream();
+    
+    // configure system components ============================================
+    ArUco_Detector::Ptr aruco_detector = system->get_aruco_detector();
+    int target_id;
+	std::cout << "Enter target_id: ";
+	std::cin >> target_id;
+    aruco_detector->set_target_id(target_id);
+
+    // initiate threads =======================================================
+    pose_filter->start_output(output_rate, [](const Fused_State& state)
+    {
+        std::cout << "position: " << state.position.transpose() << 
+            " velocity: " << state.velocity.transpose() << std::endl;
+    });
+
+    // feed Tello state -------------------------------------------------------
+    // Tello sends state at about 10 Hz; polled faster, each packet is used
+    // once, stamped with its arrival rather than the poll
+    Flight_Recorder::Ptr flight_recorder = system->get_flight_recorder(); // optional
+    std::atomic<bool> running(true);
+    std::thread imu_thread([&]
+    {
+        Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / imu_rate));
+        Timestamp t_next = Clock::now();
+        uint64_t last_sequence = 0; // none received yet
+
+        while (running)
+        {
+            Tello::TelloState state = tello.state();
+            if (state.sequence != last_sequence)
+            {
+                last_sequence = state.sequence;
+
+                pose_filter->add_imu(IMU_Sample::from_tello_state(
+                    state, state.arrival, velocity_scale, acceleration_scale));
+
+                if (flight_recorder)
+                {
+                    flight_recorder->record_tello_state(
+                        std::chrono::duration_cast<std::chrono::milliseconds>(
+                        state.arrival_system.time_since_epoch()).count(), state);
+                }
+            }
+
+            t_next += period;
+            std::this_thread::sleep_until(t_next);
+        }
+    });
+
+    aruco_detector->run(); // until ESC or signal
+
+    running = false;
+    imu_thread.join();
+    pose_filter->stop_output();
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+// generate_synthetic_video.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include <iostream>
+
+#include "port/config.h"
+#include "system.h"
+#include "marker/aruco_detector.h"
+#include "marker/scene_generator.h"
+
+using namespace tello_basic;
+
+
+/**
+ * render configured markers at known poses into a video, no camera needed.
+ * usage: generate_synthetic_video [video] [ground_truth_csv]
+ * (default: synthetic.avi, synthetic.avi.csv)
+ * the video can be fed back through video_file_path or benchmark_stages.
+ */
+int main(int argc, char **argv)
+{
+    // configure system =======================================================
+    std::string configuration_file_path = "./config/system_config.yaml";
+    
+    System::Ptr system = std::make_shared<System>(configuration_file_path);    
+    assert(system->initialize() == true);
+
+    ArUco_Detector::Ptr aruco_detector = system->get_aruco_detector();
+    Camera::Ptr camera = system->get_mono_camera();
+
+    // markers: synthetic_IDs or primary target ===============================
+    std::vector<int> ids;
+    cv::FileNode synthetic_ids = Config::read<cv::FileNode>("synthetic_IDs");
+    for (size_t i = 0; synthetic_ids.isSeq() && i < synthetic_ids.size(); ++i)
+        ids.push_back((int)synthetic_ids[(int)i]);
+    if (ids.empty())
+        ids.push_back(aruco_detector->get_target_id());
+
+    Scene_Options options;
+    if (!camera->get_image_size().empty())
+        options.image_size = camera->get_image_size();
+    options.read_config();
+
+    int num_frames = Config::read<int>("synthetic_num_frames");
+    num_frames = num_frames > 0 ? num_frames : 300;
+
+    std::string video_file_path = argc > 1 ? argv[1] : "synthetic.avi";
+    std::string ground_truth_file_path = argc > 2 ? argv[2] : video_file_path + ".csv";
+
+    // generate ===============================================================
+    Scene_Generator scene_generator(camera, aruco_detector->get_dictionary(), 
+        aruco_detector->get_marker_length(), ids, options);
+
+    Timestamp t_start = Clock::now();
+    if (!scene_generator.write_video(video_file_path, ground_truth_file_path, num_frames))
+        return -1;
+    double elapsed = std::chrono::duration<double>(Clock::now() - t_start).count();
+
+    std::cout << "written " << num_frames << " frames to " << video_file_path 
+              << " and " << ground_truth_file_path 
+              << " (" << num_frames / elapsed << " frames/s)" << std::endl;
+
+    return 0;
+}
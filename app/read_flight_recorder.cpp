@@ -0,0 +1,75 @@
+// read_flight_recorder.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include <iostream>
+#include <fstream>
+
+#include "port/flight_recorder.h"
+
+using namespace tello_basic;
+
+
+/**
+ * dump a flight recorder ring file (flight_recorder_file) in order, as csv.
+ * works on the file of a killed or crashed process.
+ * usage: read_flight_recorder <file> [seconds] [out.csv]
+ *   seconds: keep only last seconds before newest record (default all)
+ *   out.csv: default stdout
+ * columns: sequence, t_ms, type (pose, state), id, then record values
+ */
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: read_flight_recorder <file> [seconds] [out.csv]" << std::endl;
+        return -1;
+    }
+
+    double duration = argc > 2 ? std::stod(argv[2]) : 0;
+
+    std::vector<Flight_Record> records;
+    if (!Flight_Recorder::read(argv[1], duration, records))
+        return -1;
+
+    std::ofstream file_stream;
+    if (argc > 3)
+    {
+        file_stream.open(argv[3]);
+        if (!file_stream.is_open())
+        {
+            std::cerr << "ERROR: could not open " << argv[3] << std::endl;
+            return -1;
+        }
+    }
+    std::ostream& stream = argc > 3 ? file_stream : std::cout;
+
+    stream.precision(10);
+    for (const Flight_Record& record : records)
+    {
+        bool is_pose = record.type == Flight_Record::POSE;
+        stream << record.sequence - 1 << ',' << record.t_ms << ',' 
+               << (is_pose ? "pose" : "state") << ',' << record.id;
+
+        int num_values = is_pose ? 8 : 13;
+        for (int i = 0; i < num_values; ++i)
+            stream << ',' << record.values[i];
+        stream << '\n';
+    }
+
+    std::cerr << records.size() << " records";
+    if (!records.empty())
+        std::cerr << " over " << (records.back().t_ms - records.front().t_ms) / 1000.0 << " s";
+    std::cerr << std::endl;
+
+    return 0;
+}
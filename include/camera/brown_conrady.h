@@ -50,9 +50,26 @@ public:
         camera_model_ = BROWN_CONRADY;
     }
 
+    // member methods /////////////////////////////////////////////////////////
+    // projection =============================================================
+    void project(const MatX3& p3Ds_camera, MatX2& p2Ds_pixel) const final;
+
+    /**
+     * undistort by fixed-point iteration, as cv::undistortPoints does
+     */
+    void unproject(const MatX2& p2Ds_pixel, MatX3& p3Ds_normalized) const final;
+
+    // undistortion ===========================================================
+    /**
+     * radial (k1, k2, k3) and tangential (p1, p2) distortion
+     */
+    cv::Point2d distort(const cv::Point2d& p2D_normalized) const override;
+
 private:
     // member data ////////////////////////////////////////////////////////////
     double k1_, k2_, p1_, p2_, k3_;
+
+    int num_unproject_iterations_ = 8;
 };
 
 } // namespace tello_basic
@@ -51,6 +51,67 @@ public:
     Camera() {}
     
     Camera(const std::vector<cv::Mat>& intrinsic_parameters);
+
+    virtual ~Camera() {}
+
+    // getter & setter ////////////////////////////////////////////////////////
+    // getter =================================================================
+    const cv::Size& get_image_size() const {return image_size_;}
+
+    // member methods /////////////////////////////////////////////////////////
+    // projection =============================================================
+    /**
+     * camera frame points to pixels, whole batch per call
+     * @param p3Ds_camera N x 3, in front of camera
+     */
+    virtual void project(const MatX3& p3Ds_camera, MatX2& p2Ds_pixel) const;
+
+    /**
+     * pixels to rays on normalized image plane (z = 1)
+     */
+    virtual void unproject(const MatX2& p2Ds_pixel, MatX3& p3Ds_normalized) const;
+
+    // undistortion ===========================================================
+    /**
+     * precompute rectification map and point lookup table for a resolution
+     * @param lut_step lookup table grid spacing [pixel]
+     */
+    void build_undistortion(const cv::Size& image_size, const int& lut_step = 4);
+
+    /**
+     * pixel to normalized image coordinates by bilinear table lookup.
+     * points off the table are solved iteratively.
+     */
+    void undistort_points(const std::vector<cv::Point2f>& p2Ds_pixel, 
+        std::vector<cv::Point2f>& p2Ds_normalized) const;
+
+    /**
+     * remap image to undistorted image with same camera matrix
+     */
+    void rectify(const cv::Mat& image, cv::Mat& image_rectified) const;
+
+    /**
+     * normalized undistorted to normalized distorted coordinates
+     */
+    virtual cv::Point2d distort(const cv::Point2d& p2D_normalized) const 
+        {return p2D_normalized;}
+
+    /**
+     * invert distort() by fixed-point iteration, for building tables
+     */
+    virtual cv::Point2d undistort(const cv::Point2d& p2D_pixel) const;
+
+protected:
+    // member data ////////////////////////////////////////////////////////////
+    // points per block in batch kernels, fits stack and L1 cache
+    static const int block_size_ = 64;
+    typedef Eigen::Array<double, Eigen::Dynamic, 1, 0, block_size_, 1> Block;
+
+    // undistortion ===========================================================
+    cv::Size image_size_;
+    int lut_step_ = 4;
+    cv::Mat lut_;          // CV_32FC2, normalized coordinates at grid nodes
+    cv::Mat map1_, map2_;  // fixed-point rectification map for cv::remap
 };
 
 } // namespace tello_basic
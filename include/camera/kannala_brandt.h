@@ -0,0 +1,101 @@
+// kannala_brandt.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference: 
+// Kannala and Brandt, A Generic Camera Model and Calibration Method 
+// for Conventional, Wide-Angle, and Fish-Eye Lenses
+
+
+#ifndef TELLOBASIC_CAMERA_KANNALABRANDT_H
+#define TELLOBASIC_CAMERA_KANNALABRANDT_H
+
+#include "camera/camera.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * fisheye camera, same parameterization as cv::fisheye:
+ * theta_d = theta (1 + k1 theta^2 + k2 theta^4 + k3 theta^6 + k4 theta^8)
+ */
+class Kannala_Brandt: public Camera
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+    // constructor & destructor ///////////////////////////////////////////////
+    Kannala_Brandt()
+    {
+        camera_model_ = KANNALA_BRANDT;
+    }
+
+    Kannala_Brandt(const std::vector<cv::Mat>& intrinsic_parameters)
+        : Camera(intrinsic_parameters)
+    {
+        distCoeffs_ = intrinsic_parameters.at(1);
+
+        k1_ = distCoeffs_.at<double>(0);
+        k2_ = distCoeffs_.at<double>(1);
+        k3_ = distCoeffs_.at<double>(2);
+        k4_ = distCoeffs_.at<double>(3);
+
+        camera_model_ = KANNALA_BRANDT;
+
+        build_theta_lut();
+    }
+
+    // member methods /////////////////////////////////////////////////////////
+    // projection =============================================================
+    /**
+     * also valid for points at or behind image plane (theta >= 90 deg)
+     */
+    void project(const MatX3& p3Ds_camera, MatX2& p2Ds_pixel) const final;
+
+    /**
+     * invert theta_d(theta) by table lookup
+     */
+    void unproject(const MatX2& p2Ds_pixel, MatX3& p3Ds_normalized) const final;
+
+    // undistortion ===========================================================
+    cv::Point2d distort(const cv::Point2d& p2D_normalized) const override;
+    cv::Point2d undistort(const cv::Point2d& p2D_pixel) const override;
+
+private:
+    // member data ////////////////////////////////////////////////////////////
+    double k1_, k2_, k3_, k4_;
+
+    // theta_d -> theta ======================================================
+    static const int theta_lut_size_ = 2048;
+    std::vector<double> theta_lut_; // at uniform theta_d steps
+    double theta_d_max_ = 0;        // beyond: clamped to last entry
+    double theta_d_step_inverse_ = 0;
+
+    // member methods /////////////////////////////////////////////////////////
+    double distort_theta(const double& theta) const
+    {
+        double theta2 = theta * theta;
+        return theta * (1 + theta2 * (k1_ + theta2 * (k2_ + theta2 * (k3_ + theta2 * k4_))));
+    }
+
+    /**
+     * Newton solve of theta_d(theta) once per table entry
+     */
+    void build_theta_lut();
+
+    /**
+     * linear interpolation in table
+     */
+    double undistort_theta(const double& theta_d) const;
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_CAMERA_KANNALABRANDT_H
@@ -18,6 +18,7 @@
 // std ////////////////////////////////////////////////////////////////////////
 #include <iostream>
 #include <thread>
+#include <chrono>
 
 // OpenCV /////////////////////////////////////////////////////////////////////
 #include <opencv2/opencv.hpp>
@@ -31,15 +32,25 @@
 typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> MatXX;
 typedef Eigen::Matrix<double, 2, 2> Mat22;
 typedef Eigen::Matrix<double, 3, 3> Mat33;
+typedef Eigen::Matrix<double, 6, 6> Mat66;
+
+// point buffers, structure of arrays (one column per coordinate)
+typedef Eigen::Matrix<double, Eigen::Dynamic, 2> MatX2;
+typedef Eigen::Matrix<double, Eigen::Dynamic, 3> MatX3;
 
 // double vectors
 typedef Eigen::Matrix<double, Eigen::Dynamic, 1> VecX;
 typedef Eigen::Matrix<double, 2, 1> Vec2;
 typedef Eigen::Matrix<double, 3, 1> Vec3;
 typedef Eigen::Matrix<double, 4, 1> Vec4;
+typedef Eigen::Matrix<double, 6, 1> Vec6;
 
 // double quaternion
 typedef Eigen::Quaterniond Quaternion;
 
+// time
+typedef std::chrono::steady_clock Clock; // monotonic
+typedef Clock::time_point Timestamp;
+
 
 #endif // TELLOBASIC_COMMON_H
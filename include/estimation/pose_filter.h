@@ -0,0 +1,164 @@
+// pose_filter.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference: Sola, Quaternion kinematics for the error-state Kalman filter
+
+
+#ifndef TELLOBASIC_ESTIMATION_POSEFILTER_H
+#define TELLOBASIC_ESTIMATION_POSEFILTER_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+#include "common.h"
+#include "marker/marker_pose.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * Tello state sample in SI units.
+ * world frame: Tello's own (x forward at takeoff, z down),
+ * body frame: x forward, y right, z down
+ */
+struct IMU_Sample
+{
+    Timestamp timestamp;
+    Vec3 rpy;          // roll, pitch, yaw [rad]
+    Vec3 velocity;     // in world frame [m/s]
+    Vec3 acceleration; // specific force in body frame [m/s^2]
+
+    /**
+     * convert Tello::TelloState (template, so tello.hpp is not needed here)
+     * @param velocity_scale Tello velocity unit to [m/s]
+     * @param acceleration_scale parsed Tello acceleration to [m/s^2]
+     */
+    template <typename Tello_State>
+    static IMU_Sample from_tello_state(const Tello_State& state, 
+        const Timestamp& timestamp, 
+        const double& velocity_scale, const double& acceleration_scale)
+    {
+        IMU_Sample sample;
+        sample.timestamp = timestamp;
+        sample.rpy = Vec3(state.roll, state.pitch, state.yaw) * M_PI / 180;
+        sample.velocity = Vec3(state.vgx, state.vgy, state.vgz) * velocity_scale;
+        sample.acceleration = Vec3(state.agx, state.agy, state.agz) * acceleration_scale;
+
+        return sample;
+    }
+};
+
+/**
+ * drone body pose relative to marker frame
+ */
+struct Fused_State
+{
+    Timestamp timestamp;
+    Vec3 position;          // body in marker frame [m]
+    Vec3 velocity;          // in marker frame [m/s]
+    Quaternion orientation; // body to marker
+    Mat66 covariance;       // position, velocity
+    bool valid = false;
+};
+
+/**
+ * fuse marker poses with Tello IMU state.
+ * position/velocity: Kalman filter predicted with IMU acceleration,
+ * updated by vision position and Tello velocity.
+ * orientation: IMU attitude, with IMU-world-to-marker alignment
+ * (error state) corrected at every vision update.
+ */
+class Pose_Filter
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+    typedef std::shared_ptr<Pose_Filter> Ptr;
+
+    // member data ////////////////////////////////////////////////////////////
+    // noise (standard deviations) ============================================
+    double acceleration_noise_ = 0.5;    // [m/s^2]
+    double vision_position_noise_ = 0.02; // [m]
+    double velocity_noise_ = 0.1;        // [m/s]
+    double alignment_gain_ = 0.2;        // [0, 1], per vision update
+
+    // constructor & destructor ///////////////////////////////////////////////
+    Pose_Filter();
+    ~Pose_Filter();
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * predict to sample time, then update with its velocity (thread-safe)
+     */
+    void add_imu(const IMU_Sample& sample);
+
+    /**
+     * update with target pose in camera frame (thread-safe)
+     */
+    void add_vision(const Marker_Pose& pose);
+
+    /**
+     * state predicted to given time, filter is not changed (thread-safe)
+     * @return false if not initialized by vision yet
+     */
+    bool get_state(const Timestamp& timestamp, Fused_State& state) const;
+
+    /**
+     * call back with predicted state at fixed rate on own thread
+     */
+    void start_output(const double& rate, 
+        const std::function<void(const Fused_State&)>& callback);
+    void stop_output();
+
+    void reset();
+
+private:
+    // member data ////////////////////////////////////////////////////////////
+    mutable std::mutex mutex_;
+
+    bool initialized_ = false;
+    Timestamp t_;       // filter time
+    Vec6 x_;            // position, velocity in marker frame
+    Mat66 P_;
+
+    // orientation ============================================================
+    Quaternion q_marker_world_; // IMU world to marker, estimated
+    Quaternion q_world_body_;   // latest IMU attitude
+    Vec3 acceleration_body_ = Vec3::Zero(); // latest specific force
+    bool imu_received_ = false;
+
+    Mat33 R_body_camera_; // Tello camera looks forward
+
+    // output =================================================================
+    std::thread output_thread_;
+    std::atomic<bool> output_running_{false};
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * propagate x, P with constant acceleration (lock held)
+     */
+    void predict(const double& dt, const Vec3& acceleration, 
+        Vec6& x, Mat66& P) const;
+
+    /**
+     * acceleration in marker frame without gravity (lock held)
+     */
+    Vec3 get_acceleration_marker() const;
+
+    /**
+     * Kalman update of 3 states starting at offset (lock held)
+     */
+    void update(const int& offset, const Vec3& z, const double& noise);
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_ESTIMATION_POSEFILTER_H
@@ -15,14 +15,78 @@
 #define TELLOBASIC_MARKER_ARUCODETECTOR_H
 
 #include <fstream>
+#include <atomic>
+#include <mutex>
+#include <csignal>
 
 #include "common.h"
 #include "camera/camera.h"
+#include "estimation/pose_filter.h"
+#include "marker/pose_solver.h"
+#include "marker/corner_tracker.h"
+#include "marker/marker_pose.h"
+#include "marker/roi_tracker.h"
+#include "port/flight_recorder.h"
+#include "port/frame_grabber.h"
+#include "port/pose_logger.h"
+#include "port/replay_source.h"
+#include "port/stream_recorder.h"
+#include "util/metrics.h"
+#include "util/spsc_queue.h"
 
 
 namespace tello_basic
 {
 
+/**
+ * markers found in one frame and pose of target marker
+ */
+struct Detection_Result
+{
+    Timestamp timestamp;
+
+    std::vector<int> ids;
+    std::vector<std::vector<cv::Point2f>> p2Dss_pixel;
+
+    // primary target
+    int target_index = -1;
+    bool target_found = false;
+    cv::Vec3d rvec, tvec; // target pose in camera frame {r_cm, t_cm}
+    Marker_Pose pose;     // same, for downstream users
+
+    // all targets: index into ids, and their poses
+    std::vector<int> target_indices;
+    std::vector<cv::Vec3d> rvecs, tvecs;
+    std::vector<Marker_Pose> poses;
+
+    cv::Rect roi; // searched region, empty if full frame
+    bool tracked = false; // corners from optical flow, no detection run
+
+    // work buffers for batched pose estimation
+    std::vector<cv::Point2f> p2Ds_pixel_batch, p2Ds_normalized_batch;
+    MatX3 p3Ds_camera = MatX3(4, 3); // corners of one marker, for reprojection
+    MatX2 p2Ds_reprojected = MatX2(4, 2);
+
+    /**
+     * preallocate outer storage for up to max_num_markers markers.
+     * corner vectors of markers are (re)created by detectMarkers whenever
+     * the number of markers grows, see app/check_allocations
+     */
+    void reserve(const size_t& max_num_markers)
+    {
+        ids.reserve(max_num_markers);
+        p2Dss_pixel.reserve(max_num_markers);
+
+        target_indices.reserve(max_num_markers);
+        rvecs.reserve(max_num_markers);
+        tvecs.reserve(max_num_markers);
+        poses.reserve(max_num_markers);
+
+        p2Ds_pixel_batch.reserve(4 * max_num_markers);
+        p2Ds_normalized_batch.reserve(4 * max_num_markers);
+    }
+};
+
 /**
  *
  */
@@ -37,7 +101,14 @@ public:
     {
         TELLO,
         USB,
-        VIDEO
+        VIDEO,
+        REPLAY // video file at recorded timing, deterministic
+    };
+
+    enum Execution_Mode
+    {
+        SERIAL,  // all work on one thread
+        PIPELINE // capture, detect, pose and sink stages on own threads
     };
 
     // member data ////////////////////////////////////////////////////////////
@@ -54,14 +125,63 @@ public:
     // getter & setter ////////////////////////////////////////////////////////
     // getter =================================================================
     bool get_target_found() const {return target_found_;}
+    const std::vector<cv::Point3d>& get_p3Ds_target() const {return p3Ds_target_;}
+    long get_num_dropped_frames() const;
+    long get_num_processed_frames() const {return num_processed_frames_;}
+    double get_fps() const {return fps_;}
+    Metrics::Ptr get_metrics() const {return metrics_;} // stage latencies, counters
+    int get_target_id() const {return target_id_;}
+    double get_marker_length() const {return marker_length_;}
+    const cv::aruco::Dictionary& get_dictionary() const {return dictionary_;}
+
+    /**
+     * latest primary target pose (thread-safe, for controllers)
+     * @return false if target has not been seen yet
+     */
+    bool get_latest_pose(Marker_Pose& pose) const;
 
     // setter =================================================================
     void set_target_id(const int& target_id) {target_id_ = target_id;}
+
+    /**
+     * estimate pose of these markers too (besides primary target)
+     */
+    void set_target_ids(const std::vector<int>& target_ids);
+    void set_all_targets(const bool& all_targets) {all_targets_ = all_targets;}
     void set_verbose(const bool& verbose) {verbose_ = verbose;}
+    void set_headless(const bool& headless) {headless_ = headless;}
+
+    // detection --------------------------------------------------------------
+    void set_roi_tracking(const bool& roi_tracking) {roi_tracking_ = roi_tracking;}
+    void set_multi_scale(const bool& multi_scale) {multi_scale_ = multi_scale;}
+    void set_corner_tracking(const bool& corner_tracking) {corner_tracking_ = corner_tracking;}
+    void set_adaptive_parameters(const bool& adaptive_parameters) {adaptive_parameters_ = adaptive_parameters;}
+
+    /**
+     * split full-frame search into overlapping tiles detected in parallel
+     * @param num_detection_threads 0 for all cores, 1 for no tiling
+     */
+    void set_detection_threads(const int& num_detection_threads);
+
+    // pose estimation --------------------------------------------------------
+    void set_pose_solver(const Pose_Solver::Ptr pose_solver) {pose_solver_ = pose_solver;}
+
+    /**
+     * feed primary target pose to filter after every tracked frame
+     */
+    void set_pose_filter(const Pose_Filter::Ptr pose_filter) {pose_filter_ = pose_filter;}
+
+    /**
+     * record every target pose of every output frame, whether collecting data or not
+     */
+    void set_flight_recorder(const Flight_Recorder::Ptr flight_recorder) {flight_recorder_ = flight_recorder;}
 
     // port -------------------------------------------------------------------
     void set_input_mode(const Input_Mode& input_mode) {input_mode_ = input_mode;}
 
+    // execution --------------------------------------------------------------
+    void set_execution_mode(const Execution_Mode& execution_mode) {execution_mode_ = execution_mode;}
+
     // member methods /////////////////////////////////////////////////////////
     bool run();
     bool run_as_thread();
@@ -69,17 +189,123 @@ public:
     bool run_for_data_collection_as_thread();
     void close();
 
+    /**
+     * ask running loop to finish after current frame (thread-safe)
+     */
+    void stop();
+
+    /**
+     * detect markers and estimate target pose on a single grayscale frame.
+     * reentrant: does not touch capture, output or session state.
+     */
+    Detection_Result process_frame(const cv::Mat& image, 
+        const Timestamp& timestamp) const;
+
+    /**
+     * same as above, reusing result's buffers
+     */
+    void process_frame(const cv::Mat& image, 
+        const Timestamp& timestamp, Detection_Result& result) const;
+
+    /**
+     * process next frame of a continuous stream.
+     * uses and updates temporal state (e.g. ROI tracking), so not reentrant.
+     */
+    void track_frame(const cv::Mat& image, 
+        const Timestamp& timestamp, Detection_Result& result);
+
+    /**
+     * detection half of track_frame, for timing stages separately
+     */
+    void detect_frame(const cv::Mat& image, 
+        const Timestamp& timestamp, Detection_Result& result);
+
+    /**
+     * pose half of track_frame
+     */
+    void estimate_pose_frame(Detection_Result& result);
+
+    /**
+     * forget tracked state (ROI, corners, priors), e.g. between videos
+     */
+    void reset_tracking();
+
+    /**
+     * draw detections on BGR copy of image
+     * @return drawn image, valid until next call
+     */
+    const cv::Mat& draw(const cv::Mat& image, const Detection_Result& result);
+
+    /**
+     * one csv line (t, rvec, tvec) if target was found
+     */
+    void write_pose(std::ostream& stream, const long& t_ms, 
+        const Detection_Result& result) const;
+
+    /**
+     * one csv line of frame's latency breakdown [ms], see Frame_Timing
+     * (index, t, pts, decode, retrieve, queue, grayscale, detect, pose, output, total),
+     * from arrival of the frame's first packet when the stream is recorded
+     * (tello_stream_record_file), else from decoded frame on (decode is 0)
+     */
+    static void write_latency(std::ostream& stream, const Frame& frame);
+
+    /**
+     * @return index of primary target in ids, -1 if not found
+     */
     int find_target_index(const std::vector<int>& ids) const;
 
+    bool is_target(const int& id) const;
+
 private:
     // member data ////////////////////////////////////////////////////////////
     // ArUco ==================================================================
     double marker_length_;
     
     cv::aruco::Dictionary dictionary_;
-    cv::aruco::DetectorParameters detector_parameters_;
+    cv::aruco::DetectorParameters detector_parameters_; // wide defaults
+
+    cv::Ptr<cv::aruco::ArucoDetector> detector_;          // process_frame(), never tuned
+    cv::Ptr<cv::aruco::ArucoDetector> tracking_detector_; // tracked path, tuned to target
+
+    // targets ----------------------------------------------------------------
+    std::vector<unsigned char> is_target_id_; // indexed by marker ID
+    int num_target_ids_ = 0;
+    bool all_targets_ = false;
+
+    // tracking ---------------------------------------------------------------
+    bool roi_tracking_ = false; // search only around predicted target
+    ROI_Tracker roi_tracker_;
+
+    bool corner_tracking_ = false; // optical flow between full detections
+    Corner_Tracker corner_tracker_;
+
+    // parallel ---------------------------------------------------------------
+    struct Tile
+    {
+        cv::Rect rect;
+        std::vector<int> ids;
+        std::vector<std::vector<cv::Point2f>> p2Dss_pixel;
+    };
+
+    int num_detection_threads_ = 1;
+    int tile_overlap_;     // [pixel], least; grows with expected marker
+    int tiled_overlap_ = 0; // [pixel] of current layout
+    std::vector<Tile> tiles_;
+    cv::Size tiled_image_size_;
+
+    // multi-scale ------------------------------------------------------------
+    bool multi_scale_ = false; // detect on downscaled image, refine on native
+    int pyramid_max_level_;
+    float pyramid_min_marker_size_; // [pixel] at chosen level
+    std::atomic<float> expected_marker_size_{0}; // [pixel], set by pose, read by detect
+    cv::Mat image_scaled_; // only grows, scaled search image in its top-left
 
-    cv::Ptr<cv::aruco::ArucoDetector> detector_;
+    // adaptive parameters ----------------------------------------------------
+    bool adaptive_parameters_ = false; // narrow search to expected marker size
+    float adaptive_size_margin_;       // relative, around expected perimeter
+    float tuned_marker_size_ = 0;      // [pixel] in searched image, 0 for defaults
+    int tuned_max_dimension_ = 0;      // [pixel] of searched image
 
     std::thread thread_;
 
@@ -93,14 +319,220 @@ private:
     std::vector<cv::Point3d> p3Ds_target_;
     bool target_found_;
 
+    Pose_Solver::Ptr pose_solver_;
+    std::vector<Pose_Prior> pose_priors_; // indexed by marker ID
+    Clock::duration pose_prior_timeout_;
+
+    Pose_Filter::Ptr pose_filter_; // optional
+
+    mutable std::mutex latest_pose_mutex_;
+    Marker_Pose latest_pose_;
+
+    // storage ================================================================
+    size_t max_num_markers_; // per frame, to preallocate results
+
     // port ===================================================================
     Input_Mode input_mode_;
     float resize_scale_factor_;
 
+    Frame_Source::Ptr frame_source_ = nullptr;
+    Stream_Recorder::Ptr stream_recorder_ = nullptr; // raw H.264, optional
+
+    // output =================================================================
+    bool headless_ = false; // no rendering, no window
+    cv::Mat image_;      // grayscale, serial mode
+    cv::Mat image_out_;  // BGR, for drawing
+    cv::Mat image_show_; // resized
+
+    bool rectify_display_ = false; // show undistorted image
+    cv::Mat image_rectified_;
+    std::vector<std::vector<cv::Point2f>> p2Dss_rectified_;
+    MatX3 p3Ds_axes_ = MatX3(4, 3); // target axes, drawn by camera model
+    MatX2 p2Ds_axes_;
+
+    // session ================================================================
+    std::atomic<bool> stop_requested_{false};
+
+    long num_processed_frames_ = 0;
+    double fps_ = 0;
+    Timestamp t_session_start_;
+    Timestamp t_last_report_;
+    long num_frames_at_last_report_ = 0;
+
+    Metrics::Ptr metrics_ = std::make_shared<Metrics>(); // reset per session
+
+    void (*previous_sigint_handler_)(int) = SIG_DFL;
+    void (*previous_sigterm_handler_)(int) = SIG_DFL;
+
     // data collection ========================================================
     long t_;
     std::ofstream ofstream_;
     std::string csv_file_name_;
+
+    bool binary_pose_log_ = false; // to csv_file_name_ + ".bin", off thread
+    Pose_Logger::Ptr pose_logger_ = nullptr;
+
+    Flight_Recorder::Ptr flight_recorder_ = nullptr; // optional, crash-safe
+
+    std::string latency_file_name_; // per-frame latency breakdown, optional
+    std::ofstream latency_stream_;
+
+    // pipeline ===============================================================
+    /**
+     * unit of work handed from stage to stage
+     */
+    struct Packet
+    {
+        Frame frame;
+        cv::Mat image; // grayscale
+        Detection_Result result;
+    };
+    typedef SPSC_Queue<Packet> Packet_Queue;
+
+    Execution_Mode execution_mode_;
+    size_t pipeline_queue_size_;
+    Packet_Queue::Backpressure_Policy backpressure_policy_;
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * open capture for input mode and start frame grabber on it.
+     * live streams (Tello, USB) drop stale frames, video file does not.
+     * replay decodes on the pulling thread instead.
+     * @return true if success
+     */
+    bool start_frame_source();
+
+    /**
+     * stop frame source and stream recorder, if any
+     */
+    void stop_frame_source();
+
+    /**
+     * if tello_stream_record_file is set, start recording raw stream
+     * @return url for capture: Tello stream, or recorder's forwarded copy
+     */
+    std::string open_tello_stream();
+
+    /**
+     * replay video_file_path at replay_speed (or replay_max_speed),
+     * from replay_start [s]
+     */
+    bool start_replay_source();
+
+    // session ================================================================
+    /**
+     * reset counters; in headless mode, stop on SIGINT/SIGTERM
+     */
+    void begin_session();
+
+    /**
+     * restore signal handlers and report average frame rate
+     */
+    void end_session();
+
+    bool stop_requested() const;
+
+    /**
+     * count processed frame and its detections, record its stage latencies;
+     * report frame rate every 5 s in headless mode
+     */
+    void count_frame(const Frame& frame, const Detection_Result& result);
+
+    // data collection ========================================================
+    /**
+     * open csv file, or start binary pose logger
+     */
+    void open_pose_log();
+
+    void close_pose_log();
+
+    void log_pose(const Detection_Result& result);
+
+    // main ===================================================================
+    /**
+     * capture, process and output frames one after another
+     * @param data_collection if true, write poses to csv file
+     */
+    bool run_serial(const bool& data_collection);
+
+    void detect(const cv::Mat& image, Detection_Result& result) const;
+    void detect(const cv::aruco::ArucoDetector& detector, 
+        const cv::Mat& image, Detection_Result& result) const;
+
+    /**
+     * fill target indices of detected markers
+     */
+    void find_targets(Detection_Result& result) const;
+
+    /**
+     * detect on overlapping tiles with OpenMP, merge and deduplicate.
+     * overlap is sized to hold the expected marker; if its size is unknown
+     * and the target is missed, detect once more on the whole image.
+     * @param marker_size expected marker side in image [pixel], 0 if unknown
+     */
+    void detect_tiled(const cv::Mat& image, const float& marker_size, 
+        Detection_Result& result);
+    void layout_tiles(const cv::Size& image_size, const int& overlap);
+
+    /**
+     * track corners by optical flow if possible, else
+     * detect in predicted ROI if tracking, else in full frame
+     */
+    void detect_tracked(const cv::Mat& image, Detection_Result& result);
+
+    /**
+     * coarsest pyramid level where expected marker is still large enough
+     */
+    int select_pyramid_level() const;
+
+    /**
+     * fit threshold windows and perimeter bounds to expected marker,
+     * back to defaults when target is lost
+     * @param search_size image given to detector, before tiling
+     */
+    void tune_detector_parameters(const cv::Size& search_size, 
+        const int& level, const bool& tiled);
+    /**
+     * @param pose_priors last pose per marker ID, nullptr for none
+     */
+    void estimate_pose(Detection_Result& result, 
+        const std::vector<Pose_Prior>* pose_priors = nullptr) const;
+
+    /**
+     * RMS distance between corners and reprojected target corners [pixel]
+     */
+    double compute_reprojection_error(const std::vector<cv::Point2f>& p2Ds_pixel, 
+        const Marker_Pose& pose, Detection_Result& result) const;
+
+    /**
+     * estimate pose and keep what next frames need from it
+     */
+    void estimate_pose_tracked(Detection_Result& result);
+
+    /**
+     * log and render result
+     * @return false if 'esc' pressed
+     */
+    bool output(const cv::Mat& image, 
+        const Detection_Result& result, const bool& data_collection);
+
+    /**
+     * draw detections, resize and show
+     * @return false if 'esc' pressed
+     */
+    bool render(const cv::Mat& image, const Detection_Result& result);
+
+    // pipeline ===============================================================
+    /**
+     * run capture -> detect -> pose stages on own threads
+     * and the sink (draw, log, show) on the calling thread
+     * @param data_collection if true, write poses to csv file
+     */
+    bool run_pipeline(const bool& data_collection);
+
+    void capture_stage(Packet_Queue& output_queue);
+    void detect_stage(Packet_Queue& input_queue, Packet_Queue& output_queue);
+    void pose_stage(Packet_Queue& input_queue, Packet_Queue& output_queue);
 };
 
 } // namespace tello_basic
@@ -0,0 +1,103 @@
+// corner_tracker.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+// Kalal et al., Forward-Backward Error: Automatic Detection of Tracking Failures
+
+
+#ifndef TELLOBASIC_MARKER_CORNERTRACKER_H
+#define TELLOBASIC_MARKER_CORNERTRACKER_H
+
+#include "common.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * track target corners with pyramidal Lucas-Kanade optical flow
+ * between full detections. a marker is kept only if all its corners
+ * pass the forward-backward check and its quadrilateral stays convex
+ * with a plausible area; otherwise full detection is asked for.
+ */
+class Corner_Tracker
+{
+public:
+    // constructor & destructor ///////////////////////////////////////////////
+    Corner_Tracker() {}
+
+    /**
+     * @param detection_interval frames per full detection (1: never track)
+     * @param max_forward_backward_error [pixel]
+     * @param max_area_change relative area change per frame
+     * @param window_size LK window side [pixel]
+     * @param max_level LK pyramid levels above native
+     */
+    Corner_Tracker(const int& detection_interval, 
+        const float& max_forward_backward_error, const float& max_area_change,
+        const int& window_size, const int& max_level);
+
+    // getter & setter ////////////////////////////////////////////////////////
+    // getter =================================================================
+    bool is_tracking() const {return !ids_.empty();}
+    long get_num_tracked_frames() const {return num_tracked_frames_;}
+    long get_num_failures() const {return num_failures_;}
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * track corners from last frame into image
+     * @param image grayscale, full frame
+     * @param ids, p2Dss_pixel tracked markers, buffers reused
+     * @return false if full detection is needed
+     */
+    bool track(const cv::Mat& image, std::vector<int>& ids, 
+        std::vector<std::vector<cv::Point2f>>& p2Dss_pixel);
+
+    /**
+     * restart tracking from detected markers
+     * @param target_indices markers to track, index into ids
+     */
+    void update(const cv::Mat& image, const std::vector<int>& ids, 
+        const std::vector<std::vector<cv::Point2f>>& p2Dss_pixel, 
+        const std::vector<int>& target_indices);
+
+    void reset();
+
+private:
+    // member data ////////////////////////////////////////////////////////////
+    int detection_interval_ = 5;
+    float max_forward_backward_error_ = 1.0f;
+    float max_area_change_ = 0.3f;
+    cv::Size window_size_ = cv::Size(21, 21);
+    int max_level_ = 3;
+
+    int num_frames_since_detection_ = 0;
+    long num_tracked_frames_ = 0;
+    long num_failures_ = 0;
+
+    // tracked markers, 4 corners each ========================================
+    std::vector<int> ids_;
+    std::vector<cv::Point2f> p2Ds_previous_, p2Ds_current_, p2Ds_backward_;
+
+    // buffers reused across frames ===========================================
+    std::vector<cv::Mat> pyramid_previous_, pyramid_current_;
+    std::vector<unsigned char> status_forward_, status_backward_;
+    std::vector<float> errors_;
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * check marker corners starting at p2Ds_current_[4 * i]
+     */
+    bool is_consistent(const size_t& i, const cv::Size& image_size) const;
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_MARKER_CORNERTRACKER_H
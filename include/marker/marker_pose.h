@@ -0,0 +1,105 @@
+// marker_pose.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#ifndef TELLOBASIC_MARKER_MARKERPOSE_H
+#define TELLOBASIC_MARKER_MARKERPOSE_H
+
+#include <unsupported/Eigen/EulerAngles>
+
+#include "common.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * pose of one marker in camera frame {q_cm, t_cm}, in Eigen types.
+ * fixed-size members only, so copies and conversions never allocate.
+ */
+struct Marker_Pose
+{
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW;
+
+    Timestamp timestamp;
+    int id = -1;
+
+    Quaternion q_cm = Quaternion::Identity(); // marker orientation in camera frame
+    Vec3 t_cm = Vec3::Zero();                 // marker origin in camera frame [m]
+
+    double reprojection_error = -1; // RMS over corners [pixel], -1 if unknown
+    bool valid = false;
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * set from OpenCV axis-angle and translation
+     */
+    void set(const int& marker_id, const Timestamp& t, 
+        const cv::Vec3d& rvec, const cv::Vec3d& tvec)
+    {
+        id = marker_id;
+        timestamp = t;
+
+        Vec3 axis_angle(rvec[0], rvec[1], rvec[2]);
+        double angle = axis_angle.norm();
+        q_cm = angle > 1e-12 ? 
+            Quaternion(Eigen::AngleAxisd(angle, axis_angle / angle)) : 
+            Quaternion::Identity();
+        t_cm = Vec3(tvec[0], tvec[1], tvec[2]);
+
+        valid = true;
+    }
+
+    // marker in camera =======================================================
+    Mat33 get_R_camera_marker() const {return q_cm.toRotationMatrix();}
+
+    Eigen::Isometry3d get_T_camera_marker() const
+    {
+        Eigen::Isometry3d T = Eigen::Isometry3d::Identity();
+        T.linear() = q_cm.toRotationMatrix();
+        T.translation() = t_cm;
+
+        return T;
+    }
+
+    // camera in marker =======================================================
+    Quaternion get_q_marker_camera() const {return q_cm.conjugate();}
+    Vec3 get_t_marker_camera() const {return -(q_cm.conjugate() * t_cm);}
+
+    Eigen::Isometry3d get_T_marker_camera() const
+    {
+        return get_T_camera_marker().inverse(Eigen::Isometry);
+    }
+
+    // Euler angles ===========================================================
+    /**
+     * roll, pitch, yaw [rad] of marker in camera frame, R = Rz(yaw) Ry(pitch) Rx(roll)
+     */
+    Vec3 get_rpy_camera_marker() const
+    {
+        Eigen::EulerAnglesZYXd euler_angles(q_cm);
+        return Vec3(euler_angles.gamma(), euler_angles.beta(), euler_angles.alpha());
+    }
+
+    /**
+     * roll, pitch, yaw [rad] of camera in marker frame
+     */
+    Vec3 get_rpy_marker_camera() const
+    {
+        Eigen::EulerAnglesZYXd euler_angles(get_q_marker_camera());
+        return Vec3(euler_angles.gamma(), euler_angles.beta(), euler_angles.alpha());
+    }
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_MARKER_MARKERPOSE_H
@@ -0,0 +1,116 @@
+// pose_solver.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#ifndef TELLOBASIC_MARKER_POSESOLVER_H
+#define TELLOBASIC_MARKER_POSESOLVER_H
+
+#include "common.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * last pose of a marker, used to warm-start and disambiguate
+ */
+struct Pose_Prior
+{
+    cv::Vec3d rvec, tvec;
+    Timestamp timestamp;
+    bool valid = false;
+};
+
+/**
+ * solve pose of a square marker from its 4 undistorted corners
+ * (normalized image coordinates, identity camera matrix)
+ */
+class Pose_Solver
+{
+public:
+    typedef std::shared_ptr<Pose_Solver> Ptr;
+
+    // state member ///////////////////////////////////////////////////////////
+    enum Solver_Type
+    {
+        IPPE_SQUARE,        // closed form, no prior
+        ITERATIVE,          // Levenberg-Marquardt from last pose
+        IPPE_DISAMBIGUATED  // IPPE, ambiguous solution closest to last pose
+    };
+
+    // member data ////////////////////////////////////////////////////////////
+    Solver_Type solver_type_;
+
+    // constructor & destructor ///////////////////////////////////////////////
+    virtual ~Pose_Solver() {}
+
+    /**
+     * @param solver_name "ippe_square", "iterative" or "ippe_disambiguated"
+     * @return nullptr if not known
+     */
+    static Ptr create(const std::string& solver_name);
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * @param prior last pose of this marker, nullptr if none
+     */
+    virtual void solve(const std::vector<cv::Point3d>& p3Ds_target, 
+        const cv::Mat& p2Ds_normalized, const Pose_Prior* prior, 
+        cv::Vec3d& rvec, cv::Vec3d& tvec) const = 0;
+};
+
+// ----------------------------------------------------------------------------
+class IPPE_Square_Solver: public Pose_Solver
+{
+public:
+    IPPE_Square_Solver() {solver_type_ = IPPE_SQUARE;}
+
+    void solve(const std::vector<cv::Point3d>& p3Ds_target, 
+        const cv::Mat& p2Ds_normalized, const Pose_Prior* prior, 
+        cv::Vec3d& rvec, cv::Vec3d& tvec) const override;
+};
+
+// ----------------------------------------------------------------------------
+class Iterative_Solver: public Pose_Solver
+{
+public:
+    Iterative_Solver() {solver_type_ = ITERATIVE;}
+
+    /**
+     * IPPE if no prior, then refine
+     */
+    void solve(const std::vector<cv::Point3d>& p3Ds_target, 
+        const cv::Mat& p2Ds_normalized, const Pose_Prior* prior, 
+        cv::Vec3d& rvec, cv::Vec3d& tvec) const override;
+};
+
+// ----------------------------------------------------------------------------
+class IPPE_Disambiguated_Solver: public Pose_Solver
+{
+public:
+    IPPE_Disambiguated_Solver() {solver_type_ = IPPE_DISAMBIGUATED;}
+
+    /**
+     * take solution closest in rotation to prior
+     * unless its reprojection error is much larger
+     */
+    void solve(const std::vector<cv::Point3d>& p3Ds_target, 
+        const cv::Mat& p2Ds_normalized, const Pose_Prior* prior, 
+        cv::Vec3d& rvec, cv::Vec3d& tvec) const override;
+
+private:
+    double max_error_ratio_ = 4.0;
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_MARKER_POSESOLVER_H
@@ -0,0 +1,77 @@
+// roi_tracker.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#ifndef TELLOBASIC_MARKER_ROITRACKER_H
+#define TELLOBASIC_MARKER_ROITRACKER_H
+
+#include "common.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * predict region of interest of target marker in next frame
+ * from its last corners and image velocity
+ */
+class ROI_Tracker
+{
+public:
+    // constructor & destructor ///////////////////////////////////////////////
+    ROI_Tracker() {}
+
+    /**
+     * @param expansion margin added on each side, relative to marker size
+     * @param max_num_misses consecutive misses in ROI before full-frame search
+     */
+    ROI_Tracker(const double& expansion, const int& max_num_misses);
+
+    // getter & setter ////////////////////////////////////////////////////////
+    // getter =================================================================
+    bool is_tracking() const {return tracking_;}
+    int get_num_misses() const {return num_misses_;}
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * @param roi predicted region, clamped to image
+     * @return false if full-frame search is needed
+     */
+    bool predict(const cv::Size& image_size, const Timestamp& timestamp, 
+        cv::Rect& roi) const;
+
+    /**
+     * @param p2Ds_pixel target corners in full frame, nullptr if missed
+     */
+    void update(const std::vector<cv::Point2f>* p2Ds_pixel, 
+        const Timestamp& timestamp);
+
+    void reset();
+
+private:
+    // member data ////////////////////////////////////////////////////////////
+    double expansion_ = 0.5;
+    int max_num_misses_ = 3;
+
+    bool tracking_ = false;
+    int num_misses_ = 0;
+
+    // last target bounding box
+    cv::Point2f center_;
+    cv::Point2f velocity_; // [pixel/s]
+    float size_ = 0;       // larger side
+    Timestamp t_last_;
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_MARKER_ROITRACKER_H
@@ -0,0 +1,148 @@
+// scene_generator.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#ifndef TELLOBASIC_MARKER_SCENEGENERATOR_H
+#define TELLOBASIC_MARKER_SCENEGENERATOR_H
+
+#include "common.h"
+#include "camera/camera.h"
+#include "marker/marker_pose.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * image degradation and motion of a synthetic sequence
+ */
+struct Scene_Options
+{
+    // camera -----------------------------------------------------------------
+    cv::Size image_size = cv::Size(960, 720);
+    double fps = 30;
+
+    // image ------------------------------------------------------------------
+    int background = 128;     // gray level
+    double gain = 1.0;        // global brightness factor
+    double bias = 0;          // gray levels
+    double gradient = 0.2;    // brightness change left to right, relative
+    double blur_sigma = 0.5;  // [pixel], 0 for none
+    double noise_sigma = 2.0; // gray levels, 0 for none
+
+    // motion of marker board in camera frame ---------------------------------
+    double distance_min = 0.5;    // [m]
+    double distance_max = 3.0;    // [m]
+    double max_tilt = 0.6;        // [rad], about board x and y
+    double period = 10;           // [s] of slowest motion component
+
+    unsigned long long seed = 0;
+
+    /**
+     * override defaults with synthetic_* keys present in configuration file
+     * (absent keys keep defaults, so 0 noise or blur can be set explicitly)
+     */
+    void read_config();
+};
+
+/**
+ * ground truth of one synthetic frame
+ */
+struct Synthetic_Frame
+{
+    cv::Mat image; // BGR
+    long index = -1;
+    Timestamp timestamp;
+
+    std::vector<int> ids;
+    std::vector<Marker_Pose> poses;                   // {q_cm, t_cm}
+    std::vector<std::vector<cv::Point2f>> p2Dss_pixel; // true corners, detector order
+};
+
+/**
+ * render markers of a dictionary at known poses through a camera model
+ * (distortion included), then degrade with lighting, blur and noise.
+ * markers lie side by side on one board that follows a smooth trajectory.
+ */
+class Scene_Generator
+{
+public:
+    typedef std::shared_ptr<Scene_Generator> Ptr;
+
+    // constructor & destructor ///////////////////////////////////////////////
+    Scene_Generator(const Camera::Ptr camera, 
+        const cv::aruco::Dictionary& dictionary, const double& marker_length, 
+        const std::vector<int>& ids, const Scene_Options& options);
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * next frame of in-memory stream along trajectory
+     */
+    void next_frame(Synthetic_Frame& frame);
+
+    /**
+     * render given marker poses, same order as ids
+     */
+    void render(const std::vector<Marker_Pose>& poses, Synthetic_Frame& frame);
+
+    /**
+     * write stream to video and ground truth csv
+     * (frame, id, qw, qx, qy, qz, tx, ty, tz, u0, v0, ..., u3, v3)
+     * @return false if files could not be opened
+     */
+    bool write_video(const std::string& video_file_path, 
+        const std::string& ground_truth_file_path, const long& num_frames);
+
+    /**
+     * board pose at time t [s], marker origin at board center
+     */
+    Marker_Pose get_board_pose(const double& t) const;
+
+private:
+    // member data ////////////////////////////////////////////////////////////
+    Camera::Ptr camera_;
+    double marker_length_;
+    std::vector<int> ids_;
+    Scene_Options options_;
+
+    long num_frames_ = 0;
+    Timestamp t_start_;
+
+    // rendering ==============================================================
+    std::vector<cv::Mat> textures_; // per marker, with white quiet zone
+    int texture_cell_size_ = 16;    // [pixel]
+    int quiet_zone_cells_ = 1;
+    double texture_scale_;          // texture pixels per meter
+
+    MatX3 rays_; // per image pixel (row major), on normalized plane
+    Eigen::ArrayXd s_, mx_, my_; // per image row, reused
+
+    cv::Mat image_gray_, image_float_, noise_, gradient_map_;
+    cv::Mat map_x_, map_y_;
+    cv::RNG rng_;
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * warp one texture into image_gray_ via ray-plane intersection
+     */
+    void render_marker(const cv::Mat& texture, const Marker_Pose& pose);
+
+    /**
+     * marker corners in pixels, false if behind camera
+     */
+    bool project_corners(const Marker_Pose& pose, const double& half_size, 
+        std::vector<cv::Point2f>& p2Ds_pixel) const;
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_MARKER_SCENEGENERATOR_H
@@ -0,0 +1,155 @@
+// flight_recorder.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference: mmap(2), msync(2)
+
+
+#ifndef TELLOBASIC_PORT_FLIGHTRECORDER_H
+#define TELLOBASIC_PORT_FLIGHTRECORDER_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "common.h"
+#include "marker/marker_pose.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * one fixed-size entry of the flight recorder ring
+ */
+struct Flight_Record
+{
+    enum Type
+    {
+        POSE = 1,       // values: qw, qx, qy, qz, tx, ty, tz (camera-marker), reprojection error
+        TELLO_STATE = 2 // values: roll, pitch, yaw, vgx, vgy, vgz, agx, agy, agz,
+                        //         height, battery, sea_height, templ (Tello units)
+    };
+
+    uint64_t sequence = 0; // index + 1 once complete, 0 while being written
+    int64_t t_ms = 0;      // system clock
+    int32_t type = 0;
+    int32_t id = -1;       // marker ID for POSE
+    double values[13] = {};
+};
+static_assert(sizeof(Flight_Record) == 128, "flight record layout changed");
+
+/**
+ * first page of the ring file, records follow at data_offset
+ */
+struct Flight_Recorder_Header
+{
+    static const size_t data_offset = 4096;
+
+    char magic[8] = {'T', 'F', 'L', 'I', 'G', 'H', 'T', 0};
+    uint32_t version = 1;
+    uint32_t record_size = sizeof(Flight_Record);
+    uint64_t capacity = 0; // records in ring
+    uint64_t cursor = 0;   // records ever started, next index to write
+    int64_t t_created_ms = 0;
+
+    bool is_valid() const
+    {
+        return std::memcmp(magic, Flight_Recorder_Header().magic, 8) == 0 && 
+            version == 1 && record_size == sizeof(Flight_Record) && capacity > 0;
+    }
+};
+
+/**
+ * crash-safe recorder of poses and Tello state.
+ * records go to a preallocated file mapped into memory (MAP_SHARED), so
+ * they live in the kernel's page cache the moment they are written and
+ * survive the process being killed or crashing (not a power loss).
+ * writing is a memcpy plus atomic updates of the header cursor and the
+ * record's sequence; safe from several threads.
+ * read back with read_flight_recorder.
+ */
+class Flight_Recorder
+{
+public:
+    typedef std::shared_ptr<Flight_Recorder> Ptr;
+
+    // constructor & destructor ///////////////////////////////////////////////
+    Flight_Recorder() {}
+    ~Flight_Recorder();
+
+    Flight_Recorder(const Flight_Recorder&) = delete;
+    Flight_Recorder& operator=(const Flight_Recorder&) = delete;
+
+    // getter & setter ////////////////////////////////////////////////////////
+    // getter =================================================================
+    bool is_open() const {return header_ != nullptr;}
+    uint64_t get_capacity() const {return capacity_;}
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * create (truncate) ring file and map it
+     * @param capacity records kept, older ones are overwritten
+     * @return false if file could not be created or mapped
+     */
+    bool open(const std::string& file_path, const uint64_t& capacity);
+
+    /**
+     * sync to disk and unmap
+     */
+    void close();
+
+    /**
+     * append record; its sequence is assigned here
+     */
+    void write(const Flight_Record& record);
+
+    void record_pose(const long& t_ms, const Marker_Pose& pose);
+
+    /**
+     * @param state Tello::TelloState (template, so tello.hpp is not needed here)
+     */
+    template <typename Tello_State>
+    void record_tello_state(const long& t_ms, const Tello_State& state)
+    {
+        Flight_Record record;
+        record.t_ms = t_ms;
+        record.type = Flight_Record::TELLO_STATE;
+        const double values[13] = {(double)state.roll, (double)state.pitch, (double)state.yaw, 
+            (double)state.vgx, (double)state.vgy, (double)state.vgz, 
+            (double)state.agx, (double)state.agy, (double)state.agz, 
+            (double)state.height, (double)state.battery, (double)state.sea_height, 
+            (double)state.templ};
+        std::memcpy(record.values, values, sizeof(values));
+
+        write(record);
+    }
+
+    /**
+     * complete records of a ring file, oldest first
+     * @param duration keep only last duration [s] before newest record, 0 for all
+     * @return false if file is missing or not a flight recorder file
+     */
+    static bool read(const std::string& file_path, const double& duration, 
+        std::vector<Flight_Record>& records);
+
+private:
+    // member data ////////////////////////////////////////////////////////////
+    int file_descriptor_ = -1;
+    void* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+
+    Flight_Recorder_Header* header_ = nullptr; // inside mapping
+    Flight_Record* records_ = nullptr;         // inside mapping
+    uint64_t capacity_ = 0;
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_PORT_FLIGHTRECORDER_H
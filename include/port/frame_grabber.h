@@ -0,0 +1,110 @@
+// frame_grabber.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#ifndef TELLOBASIC_PORT_FRAMEGRABBER_H
+#define TELLOBASIC_PORT_FRAMEGRABBER_H
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+#include "common.h"
+#include "port/frame_source.h"
+#include "port/stream_recorder.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * grab frames from cv::VideoCapture on a dedicated thread.
+ * only the newest frame is kept in a single slot;
+ * a frame overwritten before being pulled is counted as dropped.
+ * grab and retrieve are timed separately. timing starts once grab() has
+ * decoded the frame, or, with a stream recorder feeding the decoder, at
+ * arrival of the frame's first packet.
+ */
+class Frame_Grabber : public Frame_Source
+{
+public:
+    typedef std::shared_ptr<Frame_Grabber> Ptr;
+
+    // constructor & destructor ///////////////////////////////////////////////
+    /**
+     * @param drop_stale_frames if false, wait for the slot to be pulled
+     *        before grabbing the next frame (no frame is lost, e.g. video file)
+     */
+    Frame_Grabber(const cv::VideoCapture& cap, const bool& drop_stale_frames);
+
+    ~Frame_Grabber() override;
+
+    // getter & setter ////////////////////////////////////////////////////////
+    // getter =================================================================
+    long get_num_grabbed_frames() const override {return num_grabbed_frames_;}
+    long get_num_dropped_frames() const override {return num_dropped_frames_;}
+    bool is_running() const {return running_;}
+
+    // setter =================================================================
+    /**
+     * take frame arrival from the recorder the decoder reads from (set before start)
+     */
+    void set_stream_recorder(const Stream_Recorder::Ptr stream_recorder) 
+    {
+        stream_recorder_ = stream_recorder;
+    }
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * start grabbing thread
+     */
+    void start() override;
+
+    /**
+     * stop grabbing thread and release capture
+     */
+    void stop() override;
+
+    /**
+     * wait for a frame newer than the last pulled one.
+     * frame's image buffer is handed back to the grabber for reuse.
+     * @return false if stream ended or grabber stopped
+     */
+    bool get_latest_frame(Frame& frame) override;
+
+private:
+    // member data ////////////////////////////////////////////////////////////
+    cv::VideoCapture cap_;
+    bool drop_stale_frames_;
+    Stream_Recorder::Ptr stream_recorder_ = nullptr; // optional
+
+    std::thread thread_;
+    std::atomic<bool> running_;
+
+    // slot ===================================================================
+    std::mutex mutex_;
+    std::condition_variable condition_variable_;
+    Frame slot_;
+    bool slot_full_ = false;
+    bool stream_ended_ = false;
+
+    // statistics =============================================================
+    std::atomic<long> num_grabbed_frames_;
+    std::atomic<long> num_dropped_frames_;
+
+    // member methods /////////////////////////////////////////////////////////
+    void grab_loop();
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_PORT_FRAMEGRABBER_H
@@ -0,0 +1,83 @@
+// frame_source.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#ifndef TELLOBASIC_PORT_FRAMESOURCE_H
+#define TELLOBASIC_PORT_FRAMESOURCE_H
+
+#include "common.h"
+#include "util/metrics.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * captured image with its capture time
+ */
+struct Frame
+{
+    cv::Mat image;
+    long index = -1;     // running capture count
+    Timestamp timestamp; // steady clock, at arrival (= timing.t_arrival):
+                         // of first packet if known, else after decoding;
+                         // recording time when replaying
+    long t_ms = 0;       // system clock [ms] at same instant, for logging;
+                         // recording time when replaying
+    Frame_Timing timing; // filled by source, then by each stage
+};
+
+/**
+ * where the detector pulls frames from: live capture or replay
+ */
+class Frame_Source
+{
+public:
+    typedef std::shared_ptr<Frame_Source> Ptr;
+
+    // constructor & destructor ///////////////////////////////////////////////
+    virtual ~Frame_Source() {}
+
+    // getter & setter ////////////////////////////////////////////////////////
+    // getter =================================================================
+    virtual long get_num_grabbed_frames() const = 0;
+    virtual long get_num_dropped_frames() const = 0;
+
+    // setter =================================================================
+    /**
+     * also count grabbed and dropped frames here (set before start)
+     */
+    void set_metrics(const Metrics::Ptr metrics) {metrics_ = metrics;}
+
+    // member methods /////////////////////////////////////////////////////////
+    virtual void start() = 0;
+
+    /**
+     * stop delivering frames; a waiting get_latest_frame() returns false
+     */
+    virtual void stop() = 0;
+
+    /**
+     * wait for the next frame.
+     * frame's image buffer may be handed back to the source for reuse.
+     * @return false if stream ended or source stopped
+     */
+    virtual bool get_latest_frame(Frame& frame) = 0;
+
+protected:
+    // member data ////////////////////////////////////////////////////////////
+    Metrics::Ptr metrics_ = nullptr; // optional
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_PORT_FRAMESOURCE_H
@@ -0,0 +1,136 @@
+// pose_logger.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#ifndef TELLOBASIC_PORT_POSELOGGER_H
+#define TELLOBASIC_PORT_POSELOGGER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+#include "common.h"
+#include "util/spsc_queue.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * one logged pose, same content as a csv line (t, rvec, tvec)
+ */
+struct Pose_Record
+{
+    int64_t t_ms;   // system clock
+    double rvec[3]; // r_cm
+    double tvec[3]; // t_cm
+};
+
+/**
+ * file starts with this, then Pose_Records back to back (host byte order)
+ */
+struct Pose_Log_Header
+{
+    char magic[8] = {'T', 'P', 'O', 'S', 'E', 'L', 'O', 'G'};
+    uint32_t version = 1;
+    uint32_t record_size = sizeof(Pose_Record);
+
+    bool is_valid() const
+    {
+        return std::equal(magic, magic + 8, Pose_Log_Header().magic) && 
+            version == 1 && record_size == sizeof(Pose_Record);
+    }
+};
+
+/**
+ * write poses to a binary file on a background thread.
+ * log() only copies the record into a bounded lock-free queue; if the
+ * writer falls behind, the record is dropped and counted, never waited on.
+ * the writer drains the queue into a block and writes the block at once,
+ * so the queue and the block form a double buffer.
+ * convert to csv offline with convert_pose_log.
+ */
+class Pose_Logger
+{
+public:
+    typedef std::shared_ptr<Pose_Logger> Ptr;
+
+    // constructor & destructor ///////////////////////////////////////////////
+    /**
+     * @param queue_capacity records buffered in memory
+     * @param block_size records written per write call, at most
+     */
+    Pose_Logger(const size_t& queue_capacity = 4096, const size_t& block_size = 256);
+
+    ~Pose_Logger();
+
+    // getter & setter ////////////////////////////////////////////////////////
+    // getter =================================================================
+    long get_num_logged() const {return num_logged_;}
+    long get_num_dropped() const {return num_dropped_;}
+    bool is_open() const {return running_;}
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * write header and start writer thread; queue starts empty,
+     * so a logger can be reopened after close()
+     * @return false if file could not be opened
+     */
+    bool open(const std::string& file_path);
+
+    /**
+     * write what is still queued, stop writer thread and close file
+     */
+    void close();
+
+    /**
+     * queue record for writing (single producer, wait-free)
+     * @return false if dropped because queue is full or logger is not open
+     */
+    bool log(Pose_Record record)
+    {
+        if (!running_.load(std::memory_order_relaxed) || !queue_.try_push(record))
+        {
+            num_dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * read whole log file
+     * @return false if file is missing or not a pose log
+     */
+    static bool read(const std::string& file_path, std::vector<Pose_Record>& records);
+
+private:
+    // member data ////////////////////////////////////////////////////////////
+    SPSC_Queue<Pose_Record> queue_;
+    size_t block_size_;
+
+    std::ofstream stream_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    // statistics =============================================================
+    std::atomic<long> num_logged_{0};  // written to file
+    std::atomic<long> num_dropped_{0};
+
+    // member methods /////////////////////////////////////////////////////////
+    void write_loop();
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_PORT_POSELOGGER_H
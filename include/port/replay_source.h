@@ -0,0 +1,160 @@
+// replay_source.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#ifndef TELLOBASIC_PORT_REPLAYSOURCE_H
+#define TELLOBASIC_PORT_REPLAYSOURCE_H
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+#include "common.h"
+#include "port/frame_source.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * one encoded frame of a recording
+ */
+struct Replay_Index_Entry
+{
+    long frame;    // decode order
+    double pts_ms; // presentation time, as decoder reports it
+    double t_ms;   // recording time: pts_ms, or arrival for raw streams
+    bool keyframe; // decoding can start here
+};
+
+/**
+ * replay a recording deterministically, without dropping frames.
+ * frames are paced by their recording time (real time or scaled),
+ * or delivered as fast as they decode. frame timestamps are recording
+ * time, not wall clock, so the detector's temporal state (ROI prediction,
+ * pose priors) and the logged poses are identical from run to run.
+ * seeking uses a keyframe index read from the packets without decoding,
+ * built once and cached next to the file (<file>.replay_idx).
+ *
+ * recording time is the presentation time of container files. raw H.264
+ * has none (the demuxer counts frames at 25 FPS), so it is taken from
+ * Stream_Recorder's <file>.idx: arrival of each frame's first slice.
+ * raw streams without .idx are rejected.
+ */
+class Replay_Source : public Frame_Source
+{
+public:
+    typedef std::shared_ptr<Replay_Source> Ptr;
+
+    // constructor & destructor ///////////////////////////////////////////////
+    /**
+     * @param speed playback rate relative to recording, 0 for no pacing
+     */
+    Replay_Source(const std::string& video_file_path, const double& speed);
+
+    ~Replay_Source() override;
+
+    // getter & setter ////////////////////////////////////////////////////////
+    // getter =================================================================
+    long get_num_grabbed_frames() const override {return num_grabbed_frames_;}
+    long get_num_dropped_frames() const override {return 0;} // never
+    const std::vector<Replay_Index_Entry>& get_index() const {return index_;}
+    double get_duration() const; // [ms] of recording time
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * open decoder, load or build keyframe index
+     * @return false if file cannot be decoded
+     */
+    bool open();
+
+    /**
+     * pacing starts from first frame delivered after this
+     */
+    void start() override;
+
+    void stop() override;
+
+    /**
+     * decode next frame, waiting until it is due if paced
+     */
+    bool get_latest_frame(Frame& frame) override;
+
+    /**
+     * continue from first frame recorded at or after t
+     * @param t [ms] recording time
+     * @return false if t is past the end
+     */
+    bool seek(const double& t);
+
+private:
+    // member data ////////////////////////////////////////////////////////////
+    std::string video_file_path_;
+    double speed_;
+
+    cv::VideoCapture cap_;
+    std::vector<Replay_Index_Entry> index_;
+    long next_frame_ = 0; // decode order of next frame
+    bool arrival_timing_ = false; // recording time from .idx, not pts
+
+    // pacing =================================================================
+    bool anchor_pending_ = true; // next frame sets anchor
+    Timestamp t_anchor_;
+    double t_recording_anchor_ms_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable condition_variable_;
+    std::atomic<bool> stopped_{false};
+
+    std::atomic<long> num_grabbed_frames_{0};
+
+    // member methods /////////////////////////////////////////////////////////
+    std::string get_index_file_path() const {return video_file_path_ + ".replay_idx";}
+
+    /**
+     * @return false if cache is missing or does not match video file
+     */
+    bool load_index();
+
+    void save_index() const;
+
+    /**
+     * read packets without decoding, keyframe flags from demuxer
+     */
+    bool build_index();
+
+    /**
+     * set t_ms of index from Stream_Recorder's <file>.idx
+     * @return false if there is no .idx, or it does not match the frames
+     */
+    bool read_arrival_times();
+
+    /**
+     * raw H.264 (.h264, .264), whose presentation time is made up
+     */
+    bool is_raw_stream() const;
+
+    /**
+     * @param pts_ms presentation time reported by decoder
+     * @return [ms] recording time of that frame
+     */
+    double get_recording_time(const double& pts_ms) const;
+
+    /**
+     * size and modification time of file and .idx, to invalidate cached index
+     */
+    std::string get_file_signature() const;
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_PORT_REPLAYSOURCE_H
@@ -18,6 +18,7 @@
 #include "camera/camera.h"
 #include "camera/pinhole.h"
 #include "camera/brown_conrady.h"
+#include "camera/kannala_brandt.h"
 #include "config.h"
 
 
@@ -95,6 +96,13 @@ private:
      * read camera setting then create and set USB Camera object
      */
     void read_and_set_usb_camera();
+
+    /**
+     * precompute undistortion of camera for resolution in setting file
+     * ({camera_name}.width, {camera_name}.height), else default
+     */
+    void build_undistortion(Camera::Ptr camera, 
+        const std::string& camera_name, const cv::Size& default_image_size);
 };
 
 } // namespace tello_basic
@@ -0,0 +1,142 @@
+// stream_recorder.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference: ITU-T H.264 Annex B (byte stream format)
+
+
+#ifndef TELLOBASIC_PORT_STREAMRECORDER_H
+#define TELLOBASIC_PORT_STREAMRECORDER_H
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include "common.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * record Tello's raw H.264 stream without decoding it.
+ * receives the UDP datagrams in place of the decoder, appends them
+ * unchanged to an .h264 file (Annex B, playable as is), and forwards
+ * them over a local TCP connection to the decoder (cv::VideoCapture).
+ * an index file (<file>.idx, csv) lists every NAL unit start:
+ *   offset [byte], t_ms (system clock at arrival), nal_type, keyframe
+ * keyframe is 1 on SPS/IDR units, where decoding can start.
+ *
+ * the decoder gets the stream from the first SPS after it connected,
+ * without loss, so its demuxer counts exactly the frames forwarded.
+ * the arrival of each forwarded frame's first slice is kept, to be
+ * looked up by the presentation time the demuxer made up for it.
+ */
+class Stream_Recorder
+{
+public:
+    typedef std::shared_ptr<Stream_Recorder> Ptr;
+
+    // constructor & destructor ///////////////////////////////////////////////
+    /**
+     * @param listen_port where Tello sends video (11111)
+     * @param forward_port on 127.0.0.1, for the decoder
+     */
+    Stream_Recorder(const int& listen_port, const int& forward_port);
+
+    ~Stream_Recorder();
+
+    // getter & setter ////////////////////////////////////////////////////////
+    // getter =================================================================
+    long get_num_packets() const {return num_packets_;}
+    long get_num_bytes() const {return num_bytes_;}
+    long get_num_keyframes() const {return num_keyframes_;}
+    bool is_running() const {return running_;}
+
+    /**
+     * url for cv::VideoCapture to read the forwarded stream
+     */
+    std::string get_forward_url() const;
+
+    /**
+     * when the first packet of a decoded frame arrived (thread-safe)
+     * @param pts_ms presentation time the decoder reported (CAP_PROP_POS_MSEC)
+     * @return false if frame was not forwarded or is no longer kept
+     */
+    bool get_frame_arrival(const double& pts_ms, Timestamp& t_arrival) const;
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * bind listen port, open files and start receiving thread
+     * @return false if port or files could not be opened
+     */
+    bool start(const std::string& file_path);
+
+    void stop();
+
+private:
+    // member data ////////////////////////////////////////////////////////////
+    int listen_port_;
+    int forward_port_;
+
+    int socket_ = -1;
+    int forward_socket_ = -1; // listening for decoder
+    int decoder_socket_ = -1; // connected decoder
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    std::ofstream stream_;
+    std::ofstream index_stream_;
+
+    // NAL unit parsing across datagrams (receiving thread only)
+    uint32_t last_bytes_ = 0xFFFFFFFF; // last bytes seen, shifted in
+    long offset_ = 0;                  // bytes written so far
+    bool forwarding_ = false;          // decoder connected and SPS seen
+    bool slice_started_ = false;       // slice NAL header was last byte
+    Timestamp t_slice_;                // arrival of that header
+
+    // forwarded frames =======================================================
+    // raw H.264 demuxer makes up presentation times at 25 FPS
+    static constexpr double demuxer_fps_ = 25;
+
+    mutable std::mutex arrival_mutex_;
+    std::vector<Timestamp> frame_arrivals_; // ring, by frame number
+    long num_forwarded_frames_ = 0;         // since decoder connected
+
+    // statistics =============================================================
+    std::atomic<long> num_packets_{0};
+    std::atomic<long> num_bytes_{0};
+    std::atomic<long> num_keyframes_{0};
+
+    // member methods /////////////////////////////////////////////////////////
+    void receive_loop();
+
+    /**
+     * take decoder connection if one is pending
+     */
+    void accept_decoder();
+
+    /**
+     * send to decoder; closes connection on error
+     */
+    void forward(const uint8_t* data, const size_t& size);
+
+    /**
+     * index NAL units starting in this datagram, note arrival of frames
+     * @return position in data to forward from, size if nothing
+     */
+    size_t index_packet(const uint8_t* data, const size_t& size, 
+        const long& t_ms, const Timestamp& t_arrival);
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_PORT_STREAMRECORDER_H
@@ -18,6 +18,7 @@
 #include "port/setting.h"
 #include "camera/camera.h"
 #include "marker/aruco_detector.h"
+#include "estimation/pose_filter.h"
 
 
 namespace tello_basic
@@ -41,6 +42,14 @@ public:
     // getter & setter ////////////////////////////////////////////////////////
     // getter =================================================================
     ArUco_Detector::Ptr get_aruco_detector() const {return aruco_detector_;}
+    Camera::Ptr get_mono_camera() const {return mono_camera_;}
+    Pose_Filter::Ptr get_pose_filter() const {return pose_filter_;} // nullptr if disabled
+    Flight_Recorder::Ptr get_flight_recorder() const {return flight_recorder_;} // nullptr if disabled
+
+    /**
+     * stage latencies and counters of current session (thread-safe)
+     */
+    Metrics::Snapshot get_metrics_snapshot() const;
 
     // member methods /////////////////////////////////////////////////////////
     /**
@@ -62,6 +71,8 @@ private:
 
     // system components ======================================================
     ArUco_Detector::Ptr aruco_detector_ = nullptr;
+    Pose_Filter::Ptr pose_filter_ = nullptr;
+    Flight_Recorder::Ptr flight_recorder_ = nullptr;
 
     // ArUco Detector =========================================================
     std::string predifined_dictionary_name_;
@@ -0,0 +1,151 @@
+// latency_histogram.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference: Gil Tene, HdrHistogram (log-linear buckets)
+
+
+#ifndef TELLOBASIC_UTIL_LATENCYHISTOGRAM_H
+#define TELLOBASIC_UTIL_LATENCYHISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "common.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * fixed-bucket latency histogram, recorded without locks or allocation.
+ * buckets are 1 us wide below 8 us, then 8 per power of two
+ * (at most 12.5 % relative error) up to about 2 min; longer latencies
+ * land in the last bucket. safe to record from several threads and to
+ * snapshot concurrently (a snapshot may miss samples recorded meanwhile).
+ */
+class Latency_Histogram
+{
+public:
+    static const int num_sub_buckets = 8; // per power of two
+    static const int num_buckets = 200;
+
+    /**
+     * summary of recorded latencies [ms]
+     */
+    struct Snapshot
+    {
+        uint64_t count = 0;
+        double mean = 0;
+        double max = 0;
+        std::array<uint64_t, num_buckets> counts{};
+
+        /**
+         * @param p in [0, 100]
+         * @return middle of bucket holding nearest-rank percentile [ms]
+         */
+        double percentile(const double& p) const
+        {
+            if (count == 0)
+                return 0;
+
+            uint64_t rank = (uint64_t)std::ceil(p / 100 * count);
+            rank = std::min(std::max(rank, (uint64_t)1), count);
+
+            uint64_t num_below = 0;
+            for (int i = 0; i < num_buckets; ++i)
+            {
+                num_below += counts[i];
+                if (num_below >= rank)
+                    return std::min(0.5 * (lower_bound(i) + lower_bound(i + 1)) / 1000.0, max);
+            }
+
+            return max;
+        }
+    };
+
+    // constructor & destructor ///////////////////////////////////////////////
+    Latency_Histogram() {reset();}
+
+    // member methods /////////////////////////////////////////////////////////
+    void record(const Clock::duration& latency)
+    {
+        int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count();
+        uint64_t us = ns > 0 ? (uint64_t)ns / 1000 : 0;
+
+        counts_[bucket_index(us)].fetch_add(1, std::memory_order_relaxed);
+        sum_ns_.fetch_add(ns > 0 ? ns : 0, std::memory_order_relaxed);
+
+        int64_t max_ns = max_ns_.load(std::memory_order_relaxed);
+        while (ns > max_ns && 
+            !max_ns_.compare_exchange_weak(max_ns, ns, std::memory_order_relaxed)) {}
+    }
+
+    void record(const Timestamp& t_start, const Timestamp& t_end) {record(t_end - t_start);}
+
+    Snapshot snapshot() const
+    {
+        Snapshot snapshot;
+        for (int i = 0; i < num_buckets; ++i)
+        {
+            snapshot.counts[i] = counts_[i].load(std::memory_order_relaxed);
+            snapshot.count += snapshot.counts[i];
+        }
+        if (snapshot.count > 0)
+            snapshot.mean = sum_ns_.load(std::memory_order_relaxed) / 1e6 / snapshot.count;
+        snapshot.max = max_ns_.load(std::memory_order_relaxed) / 1e6;
+
+        return snapshot;
+    }
+
+    void reset()
+    {
+        for (std::atomic<uint64_t>& count : counts_)
+            count.store(0, std::memory_order_relaxed);
+        sum_ns_.store(0, std::memory_order_relaxed);
+        max_ns_.store(0, std::memory_order_relaxed);
+    }
+
+    // ------------------------------------------------------------------------
+    static int bucket_index(const uint64_t& us)
+    {
+        if (us < num_sub_buckets)
+            return (int)us;
+
+        int octave = 63 - __builtin_clzll(us); // >= 3
+        int mantissa = (int)(us >> (octave - 3)) & (num_sub_buckets - 1);
+
+        return std::min((octave - 2) * num_sub_buckets + mantissa, num_buckets - 1);
+    }
+
+    /**
+     * @return smallest latency [us] falling in bucket i
+     */
+    static double lower_bound(const int& i)
+    {
+        if (i < num_sub_buckets)
+            return i;
+
+        int octave = i / num_sub_buckets + 2;
+        int mantissa = i % num_sub_buckets;
+
+        return (double)((uint64_t)(num_sub_buckets + mantissa) << (octave - 3));
+    }
+
+private:
+    // member data ////////////////////////////////////////////////////////////
+    std::array<std::atomic<uint64_t>, num_buckets> counts_;
+    std::atomic<int64_t> sum_ns_;
+    std::atomic<int64_t> max_ns_;
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_UTIL_LATENCYHISTOGRAM_H
@@ -0,0 +1,162 @@
+// metrics.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#ifndef TELLOBASIC_UTIL_METRICS_H
+#define TELLOBASIC_UTIL_METRICS_H
+
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <condition_variable>
+
+#include "common.h"
+#include "util/latency_histogram.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * when one frame went through each step, on the monotonic clock.
+ * each stage ends where the next one starts, so latencies add up.
+ * first stamp is the arrival of the frame's first packet at this machine,
+ * known when Stream_Recorder feeds the decoder; otherwise the frame is
+ * first seen decoded, and DECODE is 0. Tello's encoding and Wi-Fi
+ * before arrival are never visible.
+ */
+struct Frame_Timing
+{
+    // capture ----------------------------------------------------------------
+    double pts_ms = -1;    // decoder presentation time (CAP_PROP_POS_MSEC);
+                           // made up from frame count (25 FPS) on raw H.264 streams
+    Timestamp t_arrival;   // first packet received, else = t_grabbed
+    Timestamp t_grabbed;   // grab() returned: frame received and decoded
+    Timestamp t_retrieved; // image converted to BGR
+
+    // processing -------------------------------------------------------------
+    Timestamp t_pulled;    // taken by detector
+    Timestamp t_grayscale;
+    Timestamp t_detected;
+    Timestamp t_posed;
+    Timestamp t_output;    // logged and rendered
+};
+
+/**
+ * always-on pipeline instrumentation: one latency histogram per stage and
+ * event counters, all lock-free to record. optionally appended to a file
+ * as one JSON line per period by a background thread.
+ */
+class Metrics
+{
+public:
+    typedef std::shared_ptr<Metrics> Ptr;
+
+    // state member ///////////////////////////////////////////////////////////
+    enum Stage
+    {
+        DECODE,    // first packet received to decoded: transfer, buffering, decoding
+        RETRIEVE,  // decoded to BGR image
+        QUEUE,     // BGR image to pulled by detector
+        GRAYSCALE,
+        DETECT,
+        POSE,
+        OUTPUT,    // logging and rendering
+        TOTAL,     // first packet received to end of output
+        NUM_STAGES
+    };
+
+    enum Counter
+    {
+        FRAMES_IN,
+        FRAMES_DROPPED, // by grabber or pipeline queues
+        DETECTIONS,     // markers detected, summed over frames
+        TARGET_HITS,    // frames with primary target
+        NUM_COUNTERS
+    };
+
+    static const char* const stage_names[NUM_STAGES];
+    static const char* const counter_names[NUM_COUNTERS];
+
+    /**
+     * copy of all metrics at one instant
+     */
+    struct Snapshot
+    {
+        long t_ms = 0;     // system clock
+        double uptime = 0; // [s] since reset
+        std::array<Latency_Histogram::Snapshot, NUM_STAGES> stages;
+        std::array<long, NUM_COUNTERS> counters{};
+
+        /**
+         * one line: counters, and count/mean/p50/p90/p99/max [ms] per stage
+         */
+        void write_json(std::ostream& stream) const;
+    };
+
+    // constructor & destructor ///////////////////////////////////////////////
+    Metrics();
+    ~Metrics();
+
+    // member methods /////////////////////////////////////////////////////////
+    void record(const Stage& stage, const Timestamp& t_start, const Timestamp& t_end)
+    {
+        histograms_[stage].record(t_start, t_end);
+    }
+
+    /**
+     * record every stage of a frame that went through output
+     */
+    void record(const Frame_Timing& timing);
+
+    void count(const Counter& counter, const long& n = 1)
+    {
+        counters_[counter].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    Snapshot snapshot() const;
+
+    /**
+     * clear histograms and counters, e.g. at start of session
+     */
+    void reset();
+
+    /**
+     * append a snapshot to file every period on a background thread
+     * @return false if file could not be opened
+     */
+    bool start_writing(const std::string& file_path, const double& period);
+
+    /**
+     * stop thread after writing a last snapshot
+     */
+    void stop_writing();
+
+private:
+    // member data ////////////////////////////////////////////////////////////
+    std::array<Latency_Histogram, NUM_STAGES> histograms_;
+    std::array<std::atomic<long>, NUM_COUNTERS> counters_;
+    std::atomic<Clock::rep> t_reset_; // steady clock ticks
+
+    // writer =================================================================
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable condition_variable_;
+    bool writing_ = false;
+
+    // member methods /////////////////////////////////////////////////////////
+    void write_loop(std::ofstream stream, const Clock::duration period);
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_UTIL_METRICS_H
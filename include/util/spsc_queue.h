@@ -0,0 +1,209 @@
+// spsc_queue.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference: Dmitry Vyukov, bounded MPMC queue
+
+
+#ifndef TELLOBASIC_UTIL_SPSCQUEUE_H
+#define TELLOBASIC_UTIL_SPSCQUEUE_H
+
+#include <atomic>
+#include <vector>
+
+#include "common.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * bounded lock-free single-producer/single-consumer queue.
+ * each cell carries a sequence number, so the producer may also discard
+ * the oldest item (drop-oldest policy) without racing the consumer.
+ * items are swapped in and out, so the caller gets back a used item
+ * whose buffers can be reused.
+ */
+template <typename T>
+class SPSC_Queue
+{
+public:
+    typedef std::shared_ptr<SPSC_Queue<T>> Ptr;
+
+    // state member ///////////////////////////////////////////////////////////
+    enum Backpressure_Policy
+    {
+        BLOCK,      // producer waits while full
+        DROP_OLDEST // producer discards oldest item while full
+    };
+
+    // constructor & destructor ///////////////////////////////////////////////
+    SPSC_Queue(const size_t& capacity, const Backpressure_Policy& policy)
+        : capacity_(capacity > 0 ? capacity : 1), policy_(policy),
+          cells_(capacity_), enqueue_position_(0), dequeue_position_(0),
+          closed_(false), num_dropped_(0)
+    {
+        reset();
+    }
+
+    // getter & setter ////////////////////////////////////////////////////////
+    // getter =================================================================
+    size_t get_capacity() const {return capacity_;}
+    long get_num_dropped() const {return num_dropped_;}
+    bool is_closed() const {return closed_;}
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * push according to backpressure policy (producer only)
+     * @return false if queue is closed
+     */
+    bool push(T& item)
+    {
+        int num_spins = 0;
+        while (!closed_)
+        {
+            if (try_push(item))
+                return true;
+
+            if (policy_ == DROP_OLDEST)
+            {
+                // swap into scratch so dropped buffers stay in circulation
+                if (try_pop(discarded_))
+                    ++num_dropped_;
+            }
+            else
+            {
+                back_off(num_spins);
+            }
+        }
+        return false;
+    }
+
+    /**
+     * wait for an item (consumer only)
+     * @return false if queue is closed and drained
+     */
+    bool pop(T& item)
+    {
+        int num_spins = 0;
+        for (;;)
+        {
+            if (try_pop(item))
+                return true;
+
+            if (closed_)
+                return try_pop(item); // last item pushed before close
+
+            back_off(num_spins);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    bool try_push(T& item)
+    {
+        size_t position = enqueue_position_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[position % capacity_];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+
+        if (sequence != position)
+            return false; // full
+
+        enqueue_position_.store(position + 1, std::memory_order_relaxed);
+        std::swap(cell.data, item);
+        cell.sequence.store(position + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool try_pop(T& item)
+    {
+        size_t position = dequeue_position_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& cell = cells_[position % capacity_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            long difference = (long)sequence - (long)(position + 1);
+
+            if (difference < 0)
+                return false; // empty
+
+            if (difference == 0)
+            {
+                // claim cell; producer may be discarding it concurrently
+                if (dequeue_position_.compare_exchange_weak(position, position + 1,
+                    std::memory_order_relaxed))
+                {
+                    std::swap(cell.data, item);
+                    cell.sequence.store(position + capacity_, std::memory_order_release);
+                    return true;
+                }
+            }
+            else
+            {
+                position = dequeue_position_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * wake up both ends; pop() still drains remaining items
+     */
+    void close() {closed_ = true;}
+
+    /**
+     * empty and reopen queue for reuse, e.g. after close().
+     * neither end may be using the queue meanwhile.
+     */
+    void reset()
+    {
+        for (size_t i = 0; i < capacity_; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        enqueue_position_.store(0, std::memory_order_relaxed);
+        dequeue_position_.store(0, std::memory_order_relaxed);
+        num_dropped_.store(0, std::memory_order_relaxed);
+        closed_.store(false, std::memory_order_release);
+    }
+
+private:
+    // member data ////////////////////////////////////////////////////////////
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    size_t capacity_;
+    Backpressure_Policy policy_;
+
+    std::vector<Cell> cells_;
+
+    alignas(64) std::atomic<size_t> enqueue_position_;
+    alignas(64) std::atomic<size_t> dequeue_position_;
+
+    std::atomic<bool> closed_;
+    std::atomic<long> num_dropped_;
+
+    T discarded_; // producer only
+
+    // member methods /////////////////////////////////////////////////////////
+    /**
+     * spin briefly, then sleep to not burn an idle core
+     */
+    static void back_off(int& num_spins)
+    {
+        if (++num_spins < 64)
+            std::this_thread::yield();
+        else
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_UTIL_SPSCQUEUE_H
@@ -0,0 +1,100 @@
+// statistics.h
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#ifndef TELLOBASIC_UTIL_STATISTICS_H
+#define TELLOBASIC_UTIL_STATISTICS_H
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include "common.h"
+
+
+namespace tello_basic
+{
+
+/**
+ * collect samples (e.g. latencies) and summarize them offline
+ */
+class Statistics
+{
+public:
+    // member methods /////////////////////////////////////////////////////////
+    void add(const double& sample) {samples_.push_back(sample); sorted_ = false;}
+    void clear() {samples_.clear();}
+
+    size_t size() const {return samples_.size();}
+    bool empty() const {return samples_.empty();}
+
+    double min() {return empty() ? 0 : sorted().front();}
+    double max() {return empty() ? 0 : sorted().back();}
+    double median() {return percentile(50);}
+
+    double mean() const
+    {
+        if (empty())
+            return 0;
+
+        return std::accumulate(samples_.begin(), samples_.end(), 0.0) / samples_.size();
+    }
+
+    double standard_deviation() const
+    {
+        if (samples_.size() < 2)
+            return 0;
+
+        double m = mean(), sum = 0;
+        for (const double& sample : samples_)
+            sum += (sample - m) * (sample - m);
+
+        return std::sqrt(sum / (samples_.size() - 1));
+    }
+
+    /**
+     * nearest-rank percentile
+     * @param p in [0, 100]
+     */
+    double percentile(const double& p)
+    {
+        if (empty())
+            return 0;
+
+        const std::vector<double>& samples = sorted();
+        size_t rank = (size_t)std::ceil(p / 100 * samples.size());
+        rank = std::min(std::max(rank, (size_t)1), samples.size());
+
+        return samples[rank - 1];
+    }
+
+private:
+    // member data ////////////////////////////////////////////////////////////
+    std::vector<double> samples_;
+    bool sorted_ = false;
+
+    // member methods /////////////////////////////////////////////////////////
+    const std::vector<double>& sorted()
+    {
+        if (!sorted_)
+        {
+            std::sort(samples_.begin(), samples_.end());
+            sorted_ = true;
+        }
+        return samples_;
+    }
+};
+
+} // namespace tello_basic
+
+#endif // TELLOBASIC_UTIL_STATISTICS_H
@@ -0,0 +1,95 @@
+// brown_conrady.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference: OpenCV camera calibration documentation
+
+
+#include "camera/brown_conrady.h"
+
+
+namespace tello_basic
+{
+
+// public XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// member methods /////////////////////////////////////////////////////////////
+// projection =================================================================
+void Brown_Conrady::project(const MatX3& p3Ds_camera, MatX2& p2Ds_pixel) const
+{
+    Eigen::Index num_points = p3Ds_camera.rows();
+    p2Ds_pixel.resize(num_points, 2);
+
+    // fixed-size blocks on stack, vectorized by Eigen
+    for (Eigen::Index i = 0; i < num_points; i += block_size_)
+    {
+        Eigen::Index n = std::min<Eigen::Index>(block_size_, num_points - i);
+
+        Block z_inverse = p3Ds_camera.col(2).segment(i, n).array().inverse();
+        Block x = p3Ds_camera.col(0).segment(i, n).array() * z_inverse;
+        Block y = p3Ds_camera.col(1).segment(i, n).array() * z_inverse;
+
+        Block r2 = x * x + y * y;
+        Block radial = 1 + r2 * (k1_ + r2 * (k2_ + r2 * k3_));
+        Block xy2 = 2 * x * y;
+
+        p2Ds_pixel.col(0).segment(i, n).array() = 
+            fx_ * (x * radial + p1_ * xy2 + p2_ * (r2 + 2 * x * x)) + cx_;
+        p2Ds_pixel.col(1).segment(i, n).array() = 
+            fy_ * (y * radial + p1_ * (r2 + 2 * y * y) + p2_ * xy2) + cy_;
+    }
+}
+
+// ----------------------------------------------------------------------------
+void Brown_Conrady::unproject(const MatX2& p2Ds_pixel, MatX3& p3Ds_normalized) const
+{
+    Eigen::Index num_points = p2Ds_pixel.rows();
+    p3Ds_normalized.resize(num_points, 3);
+
+    for (Eigen::Index i = 0; i < num_points; i += block_size_)
+    {
+        Eigen::Index n = std::min<Eigen::Index>(block_size_, num_points - i);
+
+        Block x_distorted = (p2Ds_pixel.col(0).segment(i, n).array() - cx_) * (1 / fx_);
+        Block y_distorted = (p2Ds_pixel.col(1).segment(i, n).array() - cy_) * (1 / fy_);
+        Block x = x_distorted;
+        Block y = y_distorted;
+
+        // x = (x_d - tangential(x)) / radial(x)
+        for (int j = 0; j < num_unproject_iterations_; ++j)
+        {
+            Block r2 = x * x + y * y;
+            Block radial_inverse = (1 + r2 * (k1_ + r2 * (k2_ + r2 * k3_))).inverse();
+            Block xy2 = 2 * x * y;
+
+            Block x_next = (x_distorted - p1_ * xy2 - p2_ * (r2 + 2 * x * x)) * radial_inverse;
+            y = (y_distorted - p1_ * (r2 + 2 * y * y) - p2_ * xy2) * radial_inverse;
+            x = x_next;
+        }
+
+        p3Ds_normalized.col(0).segment(i, n).array() = x;
+        p3Ds_normalized.col(1).segment(i, n).array() = y;
+    }
+    p3Ds_normalized.col(2).setOnes();
+}
+
+// undistortion ===============================================================
+cv::Point2d Brown_Conrady::distort(const cv::Point2d& p2D_normalized) const
+{
+    double x = p2D_normalized.x;
+    double y = p2D_normalized.y;
+
+    double r2 = x * x + y * y;
+    double radial = 1 + r2 * (k1_ + r2 * (k2_ + r2 * k3_));
+
+    return cv::Point2d(
+        x * radial + 2 * p1_ * x * y + p2_ * (r2 + 2 * x * x),
+        y * radial + p1_ * (r2 + 2 * y * y) + 2 * p2_ * x * y);
+}
+
+} // namespace tello_basic
@@ -32,4 +32,142 @@ Camera::Camera(const std::vector<cv::Mat>& intrinsic_parameters)
     cy_ = cameraMatrix_.at<double>(1, 2); 
 }
 
-} // namespace tello_basic
\ No newline at end of file
+// member methods /////////////////////////////////////////////////////////////
+// projection =================================================================
+void Camera::project(const MatX3& p3Ds_camera, MatX2& p2Ds_pixel) const
+{
+    p2Ds_pixel.resize(p3Ds_camera.rows(), 2);
+
+    // whole columns, vectorized by Eigen
+    p2Ds_pixel.col(0).array() = 
+        fx_ * p3Ds_camera.col(0).array() / p3Ds_camera.col(2).array() + cx_;
+    p2Ds_pixel.col(1).array() = 
+        fy_ * p3Ds_camera.col(1).array() / p3Ds_camera.col(2).array() + cy_;
+}
+
+// ----------------------------------------------------------------------------
+void Camera::unproject(const MatX2& p2Ds_pixel, MatX3& p3Ds_normalized) const
+{
+    p3Ds_normalized.resize(p2Ds_pixel.rows(), 3);
+
+    p3Ds_normalized.col(0).array() = (p2Ds_pixel.col(0).array() - cx_) * (1 / fx_);
+    p3Ds_normalized.col(1).array() = (p2Ds_pixel.col(1).array() - cy_) * (1 / fy_);
+    p3Ds_normalized.col(2).setOnes();
+}
+
+// undistortion ===============================================================
+void Camera::build_undistortion(const cv::Size& image_size, const int& lut_step)
+{
+    image_size_ = image_size;
+    lut_step_ = lut_step > 0 ? lut_step : 4;
+
+    // point lookup table =====================================================
+    // one node every lut_step_ pixels, last node on or past image border
+    int num_columns = (image_size.width  - 1 + lut_step_ - 1) / lut_step_ + 1;
+    int num_rows    = (image_size.height - 1 + lut_step_ - 1) / lut_step_ + 1;
+    lut_.create(num_rows + 1, num_columns + 1, CV_32FC2); // extra node for interpolation
+
+    for (int row = 0; row < lut_.rows; ++row)
+    {
+        cv::Point2f* node = lut_.ptr<cv::Point2f>(row);
+        for (int column = 0; column < lut_.cols; ++column)
+        {
+            cv::Point2d p2D_normalized = undistort(
+                cv::Point2d(column * lut_step_, row * lut_step_));
+            node[column] = cv::Point2f(p2D_normalized.x, p2D_normalized.y);
+        }
+    }
+
+    // rectification map ======================================================
+    cv::Mat map_x(image_size, CV_32FC1), map_y(image_size, CV_32FC1);
+    for (int v = 0; v < image_size.height; ++v)
+    {
+        float* x = map_x.ptr<float>(v);
+        float* y = map_y.ptr<float>(v);
+        for (int u = 0; u < image_size.width; ++u)
+        {
+            cv::Point2d p2D_distorted = distort(
+                cv::Point2d((u - cx_) / fx_, (v - cy_) / fy_));
+            x[u] = fx_ * p2D_distorted.x + cx_;
+            y[u] = fy_ * p2D_distorted.y + cy_;
+        }
+    }
+
+    // fixed-point map makes remap faster than float map
+    cv::convertMaps(map_x, map_y, map1_, map2_, CV_16SC2);
+}
+
+// ----------------------------------------------------------------------------
+void Camera::undistort_points(const std::vector<cv::Point2f>& p2Ds_pixel, 
+    std::vector<cv::Point2f>& p2Ds_normalized) const
+{
+    p2Ds_normalized.resize(p2Ds_pixel.size());
+
+    float scale = 1.0f / lut_step_;
+    for (size_t i = 0; i < p2Ds_pixel.size(); ++i)
+    {
+        const cv::Point2f& p2D_pixel = p2Ds_pixel[i];
+
+        // off table (or no table yet) ========================================
+        if (lut_.empty() || 
+            p2D_pixel.x < 0 || p2D_pixel.y < 0 || 
+            p2D_pixel.x > image_size_.width - 1 || p2D_pixel.y > image_size_.height - 1)
+        {
+            cv::Point2d p2D_normalized = undistort(cv::Point2d(p2D_pixel.x, p2D_pixel.y));
+            p2Ds_normalized[i] = cv::Point2f(p2D_normalized.x, p2D_normalized.y);
+            continue;
+        }
+
+        // bilinear interpolation between 4 nodes =============================
+        float gx = p2D_pixel.x * scale;
+        float gy = p2D_pixel.y * scale;
+        int column = (int)gx;
+        int row = (int)gy;
+        float a = gx - column;
+        float b = gy - row;
+
+        const cv::Point2f* node0 = lut_.ptr<cv::Point2f>(row) + column;
+        const cv::Point2f* node1 = lut_.ptr<cv::Point2f>(row + 1) + column;
+
+        p2Ds_normalized[i] = 
+            (node0[0] * (1 - a) + node0[1] * a) * (1 - b) + 
+            (node1[0] * (1 - a) + node1[1] * a) * b;
+    }
+}
+
+// ----------------------------------------------------------------------------
+void Camera::rectify(const cv::Mat& image, cv::Mat& image_rectified) const
+{
+    if (map1_.empty() || image.size() != image_size_)
+    {
+        // resolution not prepared, solve per call
+        if (camera_model_ == KANNALA_BRANDT)
+            cv::fisheye::undistortImage(image, image_rectified, cameraMatrix_, distCoeffs_, cameraMatrix_);
+        else
+            cv::undistort(image, image_rectified, cameraMatrix_, distCoeffs_);
+        return;
+    }
+
+    cv::remap(image, image_rectified, map1_, map2_, cv::INTER_LINEAR);
+}
+
+// ----------------------------------------------------------------------------
+cv::Point2d Camera::undistort(const cv::Point2d& p2D_pixel) const
+{
+    cv::Point2d p2D_distorted((p2D_pixel.x - cx_) / fx_, (p2D_pixel.y - cy_) / fy_);
+
+    // x = x_d - (distort(x) - x)
+    cv::Point2d p2D_normalized = p2D_distorted;
+    for (int i = 0; i < 20; ++i)
+    {
+        cv::Point2d error = distort(p2D_normalized) - p2D_distorted;
+        p2D_normalized -= error;
+
+        if (error.x * error.x + error.y * error.y < 1e-24)
+            break;
+    }
+
+    return p2D_normalized;
+}
+
+} // namespace tello_basic
@@ -0,0 +1,154 @@
+// kannala_brandt.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference: OpenCV fisheye camera model documentation
+
+
+#include "camera/kannala_brandt.h"
+
+
+namespace tello_basic
+{
+
+// public XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// member methods /////////////////////////////////////////////////////////////
+// projection =================================================================
+void Kannala_Brandt::project(const MatX3& p3Ds_camera, MatX2& p2Ds_pixel) const
+{
+    Eigen::Index num_points = p3Ds_camera.rows();
+    p2Ds_pixel.resize(num_points, 2);
+
+    for (Eigen::Index i = 0; i < num_points; i += block_size_)
+    {
+        Eigen::Index n = std::min<Eigen::Index>(block_size_, num_points - i);
+
+        auto X = p3Ds_camera.col(0).segment(i, n).array();
+        auto Y = p3Ds_camera.col(1).segment(i, n).array();
+        auto Z = p3Ds_camera.col(2).segment(i, n).array();
+
+        // angle from optical axis, from 3D point so z <= 0 is fine
+        Block r = (X * X + Y * Y).sqrt();
+        Block theta(n);
+        for (Eigen::Index j = 0; j < n; ++j)
+            theta[j] = std::atan2(r[j], Z[j]);
+
+        Block theta2 = theta * theta;
+        Block theta_d = theta * (1 + theta2 * (k1_ + theta2 * (k2_ + theta2 * (k3_ + theta2 * k4_))));
+
+        // theta_d / r, on optical axis limit of theta_d / (r / z) is z
+        Block scale = (r > 1e-12).select(theta_d / r, Z.inverse());
+
+        p2Ds_pixel.col(0).segment(i, n).array() = fx_ * X * scale + cx_;
+        p2Ds_pixel.col(1).segment(i, n).array() = fy_ * Y * scale + cy_;
+    }
+}
+
+// ----------------------------------------------------------------------------
+void Kannala_Brandt::unproject(const MatX2& p2Ds_pixel, MatX3& p3Ds_normalized) const
+{
+    Eigen::Index num_points = p2Ds_pixel.rows();
+    p3Ds_normalized.resize(num_points, 3);
+
+    for (Eigen::Index i = 0; i < num_points; i += block_size_)
+    {
+        Eigen::Index n = std::min<Eigen::Index>(block_size_, num_points - i);
+
+        Block x_distorted = (p2Ds_pixel.col(0).segment(i, n).array() - cx_) * (1 / fx_);
+        Block y_distorted = (p2Ds_pixel.col(1).segment(i, n).array() - cy_) * (1 / fy_);
+        Block theta_d = (x_distorted * x_distorted + y_distorted * y_distorted).sqrt();
+
+        // r / theta_d with r = tan(theta)
+        Block scale(n);
+        for (Eigen::Index j = 0; j < n; ++j)
+        {
+            scale[j] = theta_d[j] > 1e-12 ? 
+                std::tan(undistort_theta(theta_d[j])) / theta_d[j] : 1.0;
+        }
+
+        p3Ds_normalized.col(0).segment(i, n).array() = x_distorted * scale;
+        p3Ds_normalized.col(1).segment(i, n).array() = y_distorted * scale;
+    }
+    p3Ds_normalized.col(2).setOnes();
+}
+
+// undistortion ===============================================================
+cv::Point2d Kannala_Brandt::distort(const cv::Point2d& p2D_normalized) const
+{
+    double r = std::sqrt(p2D_normalized.x * p2D_normalized.x + 
+        p2D_normalized.y * p2D_normalized.y);
+    if (r < 1e-12)
+        return p2D_normalized;
+
+    return p2D_normalized * (distort_theta(std::atan(r)) / r);
+}
+
+// ----------------------------------------------------------------------------
+cv::Point2d Kannala_Brandt::undistort(const cv::Point2d& p2D_pixel) const
+{
+    cv::Point2d p2D_distorted((p2D_pixel.x - cx_) / fx_, (p2D_pixel.y - cy_) / fy_);
+
+    double theta_d = std::sqrt(p2D_distorted.x * p2D_distorted.x + 
+        p2D_distorted.y * p2D_distorted.y);
+    if (theta_d < 1e-12)
+        return p2D_distorted;
+
+    return p2D_distorted * (std::tan(undistort_theta(theta_d)) / theta_d);
+}
+
+// private XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// member methods /////////////////////////////////////////////////////////////
+void Kannala_Brandt::build_theta_lut()
+{
+    // valid range: theta below 90 deg where theta_d is still increasing ======
+    const double theta_step = 1e-4;
+    double theta_max = theta_step;
+    while (theta_max + theta_step < CV_PI / 2 - 1e-3 && 
+        distort_theta(theta_max + theta_step) > distort_theta(theta_max))
+    {
+        theta_max += theta_step;
+    }
+    theta_d_max_ = distort_theta(theta_max);
+    theta_d_step_inverse_ = (theta_lut_size_ - 1) / theta_d_max_;
+
+    // Newton per entry, warm started from previous =========================
+    theta_lut_.resize(theta_lut_size_);
+    double theta = 0;
+    for (int i = 0; i < theta_lut_size_; ++i)
+    {
+        double theta_d = i / theta_d_step_inverse_;
+        for (int j = 0; j < 20; ++j)
+        {
+            double theta2 = theta * theta;
+            double derivative = 1 + theta2 * (3 * k1_ + theta2 * (5 * k2_ + 
+                theta2 * (7 * k3_ + theta2 * 9 * k4_)));
+            double step = (distort_theta(theta) - theta_d) / derivative;
+            theta = std::min(std::max(theta - step, 0.0), theta_max);
+
+            if (std::abs(step) < 1e-14)
+                break;
+        }
+        theta_lut_[i] = theta;
+    }
+}
+
+// ----------------------------------------------------------------------------
+double Kannala_Brandt::undistort_theta(const double& theta_d) const
+{
+    double index = theta_d * theta_d_step_inverse_;
+    if (index >= theta_lut_size_ - 1)
+        return theta_lut_.back();
+
+    int i = (int)index;
+    double a = index - i;
+
+    return theta_lut_[i] * (1 - a) + theta_lut_[i + 1] * a;
+}
+
+} // namespace tello_basic
@@ -0,0 +1,234 @@
+// pose_filter.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference: Sola, Quaternion kinematics for the error-state Kalman filter
+
+
+#include "estimation/pose_filter.h"
+
+
+namespace tello_basic
+{
+
+// gravity in Tello world frame (z down)
+static const Vec3 gravity_world(0, 0, 9.81);
+
+// roll, pitch, yaw (ZYX) to quaternion
+static Quaternion quaternion_from_rpy(const Vec3& rpy)
+{
+    return Quaternion(
+        Eigen::AngleAxisd(rpy[2], Vec3::UnitZ()) *
+        Eigen::AngleAxisd(rpy[1], Vec3::UnitY()) *
+        Eigen::AngleAxisd(rpy[0], Vec3::UnitX()));
+}
+
+// public XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// constructor & destructor ///////////////////////////////////////////////////
+Pose_Filter::Pose_Filter()
+{
+    // camera (x right, y down, z forward) in body (x forward, y right, z down)
+    R_body_camera_ << 0, 0, 1,
+                      1, 0, 0,
+                      0, 1, 0;
+
+    reset();
+}
+
+Pose_Filter::~Pose_Filter()
+{
+    stop_output();
+}
+
+// member methods /////////////////////////////////////////////////////////////
+void Pose_Filter::add_imu(const IMU_Sample& sample)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // predict with last acceleration (zero-order hold) =======================
+    if (initialized_)
+    {
+        double dt = std::chrono::duration<double>(sample.timestamp - t_).count();
+        if (dt > 0)
+        {
+            predict(dt, get_acceleration_marker(), x_, P_);
+            t_ = sample.timestamp;
+        }
+    }
+
+    q_world_body_ = quaternion_from_rpy(sample.rpy);
+    acceleration_body_ = sample.acceleration;
+    imu_received_ = true;
+
+    // update with Tello velocity =============================================
+    if (initialized_)
+    {
+        update(3, q_marker_world_ * sample.velocity, velocity_noise_);
+    }
+}
+
+// ----------------------------------------------------------------------------
+void Pose_Filter::add_vision(const Marker_Pose& pose)
+{
+    const Timestamp& timestamp = pose.timestamp;
+
+    // body pose in marker frame ==============================================
+    Vec3 position = pose.get_t_marker_camera(); // camera offset ignored
+    Quaternion q_marker_body(pose.get_q_marker_camera() * R_body_camera_.transpose());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Quaternion q_world_body = imu_received_ ? q_world_body_ : Quaternion::Identity();
+    Quaternion q_marker_world = q_marker_body * q_world_body.conjugate();
+
+    // initialize =============================================================
+    if (!initialized_)
+    {
+        x_ << position, Vec3::Zero();
+        P_.setZero();
+        P_.topLeftCorner<3, 3>() = Mat33::Identity() * vision_position_noise_ * vision_position_noise_;
+        P_.bottomRightCorner<3, 3>() = Mat33::Identity();
+
+        q_marker_world_ = q_marker_world;
+        t_ = timestamp;
+        initialized_ = true;
+        return;
+    }
+
+    // predict to measurement; late measurement is applied at filter time ====
+    double dt = std::chrono::duration<double>(timestamp - t_).count();
+    if (dt > 0)
+    {
+        predict(dt, get_acceleration_marker(), x_, P_);
+        t_ = timestamp;
+    }
+
+    update(0, position, vision_position_noise_);
+
+    // correct alignment error ================================================
+    double gain = imu_received_ ? alignment_gain_ : 1.0;
+    q_marker_world_ = q_marker_world_.slerp(gain, q_marker_world).normalized();
+}
+
+// ----------------------------------------------------------------------------
+bool Pose_Filter::get_state(const Timestamp& timestamp, Fused_State& state) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    state.valid = initialized_;
+    if (!initialized_)
+        return false;
+
+    Vec6 x = x_;
+    Mat66 P = P_;
+    double dt = std::chrono::duration<double>(timestamp - t_).count();
+    if (dt > 0)
+        predict(dt, get_acceleration_marker(), x, P);
+
+    state.timestamp = timestamp;
+    state.position = x.head<3>();
+    state.velocity = x.tail<3>();
+    state.orientation = q_marker_world_ * (imu_received_ ? q_world_body_ : Quaternion::Identity());
+    state.covariance = P;
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+void Pose_Filter::start_output(const double& rate, 
+    const std::function<void(const Fused_State&)>& callback)
+{
+    stop_output();
+
+    output_running_ = true;
+    output_thread_ = std::thread([this, rate, callback]
+    {
+        Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / rate));
+        Timestamp t_next = Clock::now();
+
+        Fused_State state;
+        while (output_running_)
+        {
+            t_next += period;
+            std::this_thread::sleep_until(t_next);
+
+            if (get_state(Clock::now(), state))
+                callback(state);
+        }
+    });
+}
+
+void Pose_Filter::stop_output()
+{
+    output_running_ = false;
+    if (output_thread_.joinable())
+        output_thread_.join();
+}
+
+// ----------------------------------------------------------------------------
+void Pose_Filter::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    initialized_ = false;
+    x_.setZero();
+    P_.setIdentity();
+    q_marker_world_.setIdentity();
+    q_world_body_.setIdentity();
+    acceleration_body_.setZero();
+    imu_received_ = false;
+}
+
+// private XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// member methods /////////////////////////////////////////////////////////////
+void Pose_Filter::predict(const double& dt, const Vec3& acceleration, 
+    Vec6& x, Mat66& P) const
+{
+    // constant acceleration over dt ==========================================
+    x.head<3>() += x.tail<3>() * dt + acceleration * (0.5 * dt * dt);
+    x.tail<3>() += acceleration * dt;
+
+    Mat66 F = Mat66::Identity();
+    F.topRightCorner<3, 3>() = Mat33::Identity() * dt;
+
+    // white acceleration noise
+    double q = acceleration_noise_ * acceleration_noise_;
+    Mat66 Q = Mat66::Zero();
+    Q.topLeftCorner<3, 3>()     = Mat33::Identity() * q * dt * dt * dt * dt / 4;
+    Q.topRightCorner<3, 3>()    = Mat33::Identity() * q * dt * dt * dt / 2;
+    Q.bottomLeftCorner<3, 3>()  = Mat33::Identity() * q * dt * dt * dt / 2;
+    Q.bottomRightCorner<3, 3>() = Mat33::Identity() * q * dt * dt;
+
+    P = F * P * F.transpose() + Q;
+}
+
+// ----------------------------------------------------------------------------
+Vec3 Pose_Filter::get_acceleration_marker() const
+{
+    if (!imu_received_)
+        return Vec3::Zero();
+
+    Vec3 acceleration_world = q_world_body_ * acceleration_body_ + gravity_world;
+
+    return q_marker_world_ * acceleration_world;
+}
+
+// ----------------------------------------------------------------------------
+void Pose_Filter::update(const int& offset, const Vec3& z, const double& noise)
+{
+    Vec3 innovation = z - x_.segment<3>(offset);
+    Mat33 S = P_.block<3, 3>(offset, offset) + Mat33::Identity() * noise * noise;
+    Eigen::Matrix<double, 6, 3> K = P_.block<6, 3>(0, offset) * S.inverse();
+
+    x_ += K * innovation;
+    P_ -= K * P_.block<3, 6>(offset, 0);
+}
+
+} // namespace tello_basic
@@ -12,8 +12,12 @@
 // https://stackoverflow.com/questions/997946/how-to-get-current-time-and-date-in-c
 
 
-#include <unsupported/Eigen/EulerAngles>
 #include <chrono>
+#include <csignal>
+#include <iomanip>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "marker/aruco_detector.h"
 #include "port/config.h"
@@ -22,6 +26,14 @@
 namespace tello_basic
 {
 
+// set from signal handler, so only a lock-free atomic may be touched
+static std::atomic<bool> signal_received(false);
+
+static void handle_signal(int)
+{
+    signal_received = true;
+}
+
 // public XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
 // constructor & destructor ///////////////////////////////////////////////////
 ArUco_Detector::ArUco_Detector() {}
@@ -55,8 +67,96 @@ ArUco_Detector::ArUco_Detector(const int& target_id,
     detector_parameters_ = cv::aruco::DetectorParameters();
 
     detector_ = std::make_shared<cv::aruco::ArucoDetector>(dictionary_, detector_parameters_);
+    tracking_detector_ = std::make_shared<cv::aruco::ArucoDetector>(dictionary_, detector_parameters_);
+
+    // targets ----------------------------------------------------------------
+    // target_IDs: "all" or a sequence; target_ID stays the primary target
+    is_target_id_ = std::vector<unsigned char>(dictionary_.bytesList.rows, 0);
+
+    cv::FileNode target_ids = Config::read<cv::FileNode>("target_IDs");
+    if (target_ids.isString() && target_ids.string() == "all")
+    {
+        set_all_targets(true);
+    }
+    else if (target_ids.isSeq())
+    {
+        std::vector<int> ids;
+        for (size_t i = 0; i < target_ids.size(); ++i)
+            ids.push_back((int)target_ids[(int)i]);
+        set_target_ids(ids);
+    }
+
+    // tracking ---------------------------------------------------------------
+    roi_tracking_ = Config::read<int>("roi_tracking") != 0;
+    if (roi_tracking_ && (all_targets_ || num_target_ids_ > 1))
+    {
+        std::cout << "WARNING: ROI tracking follows primary target only, "
+                  << "disabled for multiple targets" << std::endl;
+        roi_tracking_ = false;
+    }
+
+    double roi_expansion = Config::read<double>("roi_expansion");
+    int roi_max_num_misses = Config::read<int>("roi_max_num_misses");
+    roi_tracker_ = ROI_Tracker(roi_expansion > 0 ? roi_expansion : 0.5,
+        roi_max_num_misses > 0 ? roi_max_num_misses : 3);
+
+    // detection_interval: frames per full detection while corners are tracked
+    corner_tracking_ = Config::read<int>("corner_tracking") != 0;
+
+    int detection_interval = Config::read<int>("detection_interval");
+    float klt_max_forward_backward_error = Config::read<float>("klt_max_forward_backward_error");
+    float klt_max_area_change = Config::read<float>("klt_max_area_change");
+    int klt_window_size = Config::read<int>("klt_window_size");
+    int klt_max_level = Config::read<int>("klt_max_level");
+    corner_tracker_ = Corner_Tracker(
+        detection_interval > 0 ? detection_interval : 5,
+        klt_max_forward_backward_error > 0 ? klt_max_forward_backward_error : 1.0f,
+        klt_max_area_change > 0 ? klt_max_area_change : 0.3f,
+        klt_window_size > 0 ? klt_window_size : 21,
+        klt_max_level > 0 ? klt_max_level : 3);
+
+    // parallel ---------------------------------------------------------------
+    // detection_threads: 0 for all cores, 1 for no tiling
+    int num_detection_threads = Config::read<int>("detection_threads");
+    set_detection_threads(num_detection_threads);
+
+    int tile_overlap = Config::read<int>("tile_overlap");
+    tile_overlap_ = tile_overlap > 0 ? tile_overlap : 96;
+
+    multi_scale_ = Config::read<int>("multi_scale") != 0;
+
+    int pyramid_max_level = Config::read<int>("pyramid_max_level");
+    pyramid_max_level_ = pyramid_max_level > 0 ? pyramid_max_level : 2;
+
+    float pyramid_min_marker_size = Config::read<float>("pyramid_min_marker_size");
+    pyramid_min_marker_size_ = pyramid_min_marker_size > 0 ? pyramid_min_marker_size : 40;
+
+    // adaptive parameters follow primary target size only
+    adaptive_parameters_ = Config::read<int>("adaptive_parameters") != 0;
+    if (adaptive_parameters_ && (all_targets_ || num_target_ids_ > 1))
+    {
+        std::cout << "WARNING: adaptive parameters fit primary target only, "
+                  << "disabled for multiple targets" << std::endl;
+        adaptive_parameters_ = false;
+    }
+
+    float adaptive_size_margin = Config::read<float>("adaptive_size_margin");
+    adaptive_size_margin_ = adaptive_size_margin > 0 ? adaptive_size_margin : 0.5f;
     
     // PnP --------------------------------------------------------------------
+    std::string pose_solver_name = Config::read<std::string>("pose_solver");
+    pose_solver_ = Pose_Solver::create(pose_solver_name.empty() ? "ippe_square" : pose_solver_name);
+    if (pose_solver_ == nullptr)
+    {
+        std::cout << "ERROR: pose solver " << pose_solver_name << " not known, using ippe_square" << std::endl;
+        pose_solver_ = Pose_Solver::create("ippe_square");
+    }
+
+    double pose_prior_timeout = Config::read<double>("pose_prior_timeout");
+    pose_prior_timeout_ = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(pose_prior_timeout > 0 ? pose_prior_timeout : 0.5));
+    pose_priors_ = std::vector<Pose_Prior>(dictionary_.bytesList.rows);
+
     cv::Point3d p3D0_target(-marker_length / 2,  marker_length / 2, 0);
     cv::Point3d p3D1_target( marker_length / 2,  marker_length / 2, 0);
     cv::Point3d p3D2_target( marker_length / 2, -marker_length / 2, 0);
@@ -71,149 +171,277 @@ ArUco_Detector::ArUco_Detector(const int& target_id,
         input_mode_ = Input_Mode::USB;
     else if (input_mode == "video")
         input_mode_ = Input_Mode::VIDEO;
+    else if (input_mode == "replay")
+        input_mode_ = Input_Mode::REPLAY;
     else
         std::cout << "ERROR: input mode wrong\n";
 
     resize_scale_factor_ = Config::read<float>("resize_scale_factor");
+    headless_ = Config::read<int>("headless") != 0;
+    rectify_display_ = Config::read<int>("rectify_display") != 0;
+
+    int max_num_markers = Config::read<int>("max_num_markers");
+    max_num_markers_ = max_num_markers > 0 ? max_num_markers : 16;
 
     // data collection ========================================================
     csv_file_name_ = Config::read<std::string>("csv_file_name");
+    latency_file_name_ = Config::read<std::string>("latency_file");
+    binary_pose_log_ = Config::read<std::string>("pose_log_format") == "binary";
+
+    // execution ==============================================================
+    std::string execution_mode = Config::read<std::string>("execution_mode");
+    if (execution_mode == "pipeline")
+        execution_mode_ = Execution_Mode::PIPELINE;
+    else
+        execution_mode_ = Execution_Mode::SERIAL;
+
+    // stages share tracking state, so their output depends on thread timing
+    if (execution_mode_ == Execution_Mode::PIPELINE && input_mode_ == Input_Mode::REPLAY)
+    {
+        std::cout << "[ArUco Detector] replay runs serial, to be deterministic." << std::endl;
+        execution_mode_ = Execution_Mode::SERIAL;
+    }
+
+    int pipeline_queue_size = Config::read<int>("pipeline_queue_size");
+    pipeline_queue_size_ = pipeline_queue_size > 0 ? pipeline_queue_size : 2;
+
+    std::string pipeline_backpressure = Config::read<std::string>("pipeline_backpressure");
+    if (pipeline_backpressure == "drop_oldest")
+        backpressure_policy_ = Packet_Queue::DROP_OLDEST;
+    else
+        backpressure_policy_ = Packet_Queue::BLOCK;
 }
 
 // member methods /////////////////////////////////////////////////////////////
 bool ArUco_Detector::run()
 {
-    // image //////////////////////////////////////////////////////////////////
-    cv::Mat image, image_out;
-
-    // port ///////////////////////////////////////////////////////////////////
-    cv::VideoCapture cap;
-    switch (input_mode_)
+    if (execution_mode_ == PIPELINE)
     {
-        case TELLO:
-            cap = cv::VideoCapture(Config::read<std::string>("tello_video_stream"), cv::CAP_FFMPEG);
-            break;
+        return run_pipeline(false);
+    }
 
-        case USB:
-            cap = cv::VideoCapture(Config::read<int>("USB_camera_ID"));
-            break;
+    return run_serial(false);
+}
 
-        case VIDEO:
-            cap = cv::VideoCapture(Config::read<std::string>("video_file_path"));
-            break; 
-    }
-    std::cout << "[ArUco Detector] got cap." << std::endl;
+// ----------------------------------------------------------------------------
+bool ArUco_Detector::run_as_thread()
+{
+    std::cout << "[ArUco Detector] started running as thread." << std::endl;
+    thread_ = std::thread(&ArUco_Detector::run, this);
 
-    // check capture
-    if (!cap.isOpened()) 
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+bool ArUco_Detector::run_for_data_collection()
+{
+    if (execution_mode_ == PIPELINE)
     {
-        std::cerr << "ERROR: capturer is not open\n";
-        return -1;
+        return run_pipeline(true);
     }
 
-    // get FPS
-    double fps = cap.get(cv::CAP_PROP_FPS);
-    std::cout << "FPS: " << fps << std::endl;
+    return run_serial(true);
+}
 
-    // setting ////////////////////////////////////////////////////////////////
-    // ArUco ==================================================================
-    int target_index = false;
-    
-    // pose estimation ========================================================
-    cv::Vec3d rvec, tvec; // rotation, translation vectors
-    cv::Matx33d rmat;
-    
-    ///////////////////////////////////////////////////////////////////////////
-    for (;;)
+// ----------------------------------------------------------------------------
+bool ArUco_Detector::run_for_data_collection_as_thread()
+{
+    std::cout << "[ArUco Detector] started running as thread." << std::endl;
+    thread_ = std::thread(&ArUco_Detector::run_for_data_collection, this);
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::close()
+{
+    thread_.join();
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::stop()
+{
+    stop_requested_ = true;
+}
+
+// ----------------------------------------------------------------------------
+Detection_Result ArUco_Detector::process_frame(const cv::Mat& image, 
+    const Timestamp& timestamp) const
+{
+    Detection_Result result;
+    process_frame(image, timestamp, result);
+
+    return result;
+}
+
+void ArUco_Detector::process_frame(const cv::Mat& image, 
+    const Timestamp& timestamp, Detection_Result& result) const
+{
+    result.timestamp = timestamp;
+
+    detect(image, result);
+    estimate_pose(result);
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::track_frame(const cv::Mat& image, 
+    const Timestamp& timestamp, Detection_Result& result)
+{
+    detect_frame(image, timestamp, result);
+    estimate_pose_frame(result);
+}
+
+void ArUco_Detector::detect_frame(const cv::Mat& image, 
+    const Timestamp& timestamp, Detection_Result& result)
+{
+    result.timestamp = timestamp;
+
+    detect_tracked(image, result);
+}
+
+void ArUco_Detector::estimate_pose_frame(Detection_Result& result)
+{
+    estimate_pose_tracked(result);
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::reset_tracking()
+{
+    roi_tracker_.reset();
+    corner_tracker_.reset();
+    if (tuned_marker_size_ > 0)
     {
-        cap >> image;
+        tracking_detector_->setDetectorParameters(detector_parameters_);
+        tuned_marker_size_ = 0;
+    }
+    expected_marker_size_ = 0;
+    pose_priors_.assign(pose_priors_.size(), Pose_Prior());
+    {
+        std::lock_guard<std::mutex> lock(latest_pose_mutex_);
+        latest_pose_ = Marker_Pose();
+    }
+}
 
-        // check frame
-        if (image.empty()) 
-        {
-            std::cerr << "ERROR: blank frame\n";
-            break;
-        }
-        
-        // pre-processing /////////////////////////////////////////////////////
-        // convert to grayscale
-        cv::cvtColor(image, image, cv::COLOR_BGR2GRAY);
- 
-        // --------------------------------------------------------------------
-        // convert to BGR for output
-        cv::cvtColor(image, image_out, cv::COLOR_GRAY2BGR);
-        // --------------------------------------------------------------------
+// ----------------------------------------------------------------------------
+void ArUco_Detector::write_pose(std::ostream& stream, const long& t_ms, 
+    const Detection_Result& result) const
+{
+    if (!result.target_found)
+        return;
 
-        // main ///////////////////////////////////////////////////////////////
-        // detect =============================================================      
-        std::vector<int> ids;
-        std::vector<std::vector<cv::Point2f>> p2Dss_pixel, rejected_p2Dss_pixel;
-        detector_->detectMarkers(image, p2Dss_pixel, ids, rejected_p2Dss_pixel);
+    stream << t_ms << ',' << 
+        result.rvec[0] << ',' << result.rvec[1] << ',' << result.rvec[2] << ',' <<
+        result.tvec[0] << ',' << result.tvec[1] << ',' << result.tvec[2] << '\n';
+}
 
-        target_index = find_target_index(ids);
-        target_found_ = target_index >= 0;
+// ----------------------------------------------------------------------------
+void ArUco_Detector::write_latency(std::ostream& stream, const Frame& frame)
+{
+    auto ms = [](const Timestamp& t_start, const Timestamp& t_end)
+        {return std::chrono::duration<double, std::milli>(t_end - t_start).count();};
+    const Frame_Timing& timing = frame.timing;
 
-        // estimate pose ======================================================
-        if (target_found_)
-        {   
-            std::vector<cv::Point2f> p2Ds_pixel = p2Dss_pixel.at(target_index);
+    stream << frame.index << ',' << frame.t_ms << ',' 
+        << timing.pts_ms << ',' 
+        << ms(timing.t_arrival, timing.t_grabbed) << ',' 
+        << ms(timing.t_grabbed, timing.t_retrieved) << ',' 
+        << ms(timing.t_retrieved, timing.t_pulled) << ',' 
+        << ms(timing.t_pulled, timing.t_grayscale) << ',' 
+        << ms(timing.t_grayscale, timing.t_detected) << ',' 
+        << ms(timing.t_detected, timing.t_posed) << ',' 
+        << ms(timing.t_posed, timing.t_output) << ',' 
+        << ms(timing.t_arrival, timing.t_output) << '\n';
+}
 
-            // solve initial pose guess with RANSAC
-            cv::solvePnPRansac(p3Ds_target_, p2Ds_pixel, 
-                cameraMatrix_, distCoeffs_, rvec, tvec, 
-                false, cv::SOLVEPNP_IPPE_SQUARE);
-        }
+// ----------------------------------------------------------------------------
+void ArUco_Detector::set_detection_threads(const int& num_detection_threads)
+{
+    num_detection_threads_ = num_detection_threads;
 
-        // output /////////////////////////////////////////////////////////////
-        // draw ---------------------------------------------------------------
-        if (!ids.empty())
-        {
-            cv::aruco::drawDetectedMarkers(image_out, p2Dss_pixel, ids);
-        }
+#ifdef _OPENMP
+    if (num_detection_threads_ <= 0)
+        num_detection_threads_ = omp_get_max_threads();
+#else
+    num_detection_threads_ = 1;
+#endif
 
-        if (target_index >= 0)
-        {
-            cv::drawFrameAxes(image_out, cameraMatrix_, distCoeffs_, rvec, tvec, 0.1, 2);
-        }
+    tiled_image_size_ = cv::Size(); // re-layout on next frame
+}
+
+// ============================================================================
+long ArUco_Detector::get_num_dropped_frames() const
+{
+    if (frame_source_ == nullptr)
+        return 0;
+
+    return frame_source_->get_num_dropped_frames();
+}
 
-        // show ===============================================================
-        // resize
-        cv::resize(image_out, image_out, cv::Size(), resize_scale_factor_, resize_scale_factor_, cv::INTER_LINEAR);
+// ----------------------------------------------------------------------------
+bool ArUco_Detector::get_latest_pose(Marker_Pose& pose) const
+{
+    std::lock_guard<std::mutex> lock(latest_pose_mutex_);
+    pose = latest_pose_;
+
+    return pose.valid;
+}
 
-        // show
-        cv::imshow("ArUco Tracker", image_out);
-        int key = cv::waitKey(10);
-        if (key == 27)
+// ----------------------------------------------------------------------------
+void ArUco_Detector::set_target_ids(const std::vector<int>& target_ids)
+{
+    std::fill(is_target_id_.begin(), is_target_id_.end(), 0);
+    num_target_ids_ = 0;
+
+    for (const int& target_id : target_ids)
+    {
+        if (target_id < 0 || target_id >= (int)is_target_id_.size())
         {
-            break; // quit when 'esc' pressed
+            std::cout << "ERROR: target ID " << target_id << " not in dictionary" << std::endl;
+            continue;
         }
-    }
-    std::cout << "END" << std::endl;
 
-    return true;
+        if (!is_target_id_[target_id])
+            ++num_target_ids_;
+        is_target_id_[target_id] = 1;
+    }
+    all_targets_ = false;
 }
 
 // ----------------------------------------------------------------------------
-bool ArUco_Detector::run_as_thread()
+bool ArUco_Detector::is_target(const int& id) const
 {
-    std::cout << "[ArUco Detector] started running as thread." << std::endl;
-    thread_ = std::thread(&ArUco_Detector::run, this);
+    if (all_targets_ || id == target_id_)
+        return true;
 
-    return true;
+    return id >= 0 && id < (int)is_target_id_.size() && is_target_id_[id];
 }
 
 // ----------------------------------------------------------------------------
-bool ArUco_Detector::run_for_data_collection()
+int ArUco_Detector::find_target_index(const std::vector<int>& ids) const
+{
+    auto iterator = std::find(ids.begin(), ids.end(), target_id_);
+    if(iterator != ids.end())
+    {
+        return iterator - ids.begin();
+    }
+    else
+    {
+        return -1;
+    }
+}
+
+// private XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// member methods /////////////////////////////////////////////////////////////
+bool ArUco_Detector::start_frame_source()
 {
-    // image //////////////////////////////////////////////////////////////////
-    cv::Mat image, image_out;
+    if (input_mode_ == REPLAY)
+        return start_replay_source();
 
-    // port ///////////////////////////////////////////////////////////////////
     cv::VideoCapture cap;
     switch (input_mode_)
     {
         case TELLO:
-            cap = cv::VideoCapture(Config::read<std::string>("tello_video_stream"), cv::CAP_FFMPEG);
+            cap = cv::VideoCapture(open_tello_stream(), cv::CAP_FFMPEG);
             break;
 
         case USB:
@@ -223,6 +451,9 @@ bool ArUco_Detector::run_for_data_collection()
         case VIDEO:
             cap = cv::VideoCapture(Config::read<std::string>("video_file_path"));
             break; 
+
+        case REPLAY:
+            break; // above
     }
     std::cout << "[ArUco Detector] got cap." << std::endl;
 
@@ -230,140 +461,986 @@ bool ArUco_Detector::run_for_data_collection()
     if (!cap.isOpened()) 
     {
         std::cerr << "ERROR: capturer is not open\n";
-        return -1;
+        stream_recorder_ = nullptr; // stops recording
+        return false;
     }
 
     // get FPS
     double fps = cap.get(cv::CAP_PROP_FPS);
     std::cout << "FPS: " << fps << std::endl;
 
-    // setting ////////////////////////////////////////////////////////////////
-    // ArUco ==================================================================
-    int target_index = false;
-    
-    // pose estimation ========================================================
-    cv::Vec3d rvec, tvec; // rotation, translation vectors:{r_cm, t_cm}
-    cv::Matx33d rmat;
+    // grab on own thread =====================================================
+    bool drop_stale_frames = input_mode_ != VIDEO;
+    Frame_Grabber::Ptr frame_grabber = std::make_shared<Frame_Grabber>(cap, drop_stale_frames);
+    frame_grabber->set_stream_recorder(stream_recorder_); // frame arrival, if recording
+    frame_source_ = frame_grabber;
+    frame_source_->set_metrics(metrics_);
+    frame_source_->start();
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+bool ArUco_Detector::start_replay_source()
+{
+    double replay_speed = Config::read<double>("replay_speed");
+    replay_speed = replay_speed > 0 ? replay_speed : 1.0;
+    if (Config::read<int>("replay_max_speed") != 0)
+        replay_speed = 0; // no pacing
+
+    Replay_Source::Ptr replay_source = std::make_shared<Replay_Source>(
+        Config::read<std::string>("video_file_path"), replay_speed);
+    if (!replay_source->open())
+        return false;
+
+    double replay_start = Config::read<double>("replay_start"); // [s]
+    if (replay_start > 0 && !replay_source->seek(replay_start * 1000))
+    {
+        std::cerr << "ERROR: replay_start is past the end\n";
+        return false;
+    }
+
+    frame_source_ = replay_source;
+    frame_source_->set_metrics(metrics_);
+    frame_source_->start();
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+std::string ArUco_Detector::open_tello_stream()
+{
+    std::string url = Config::read<std::string>("tello_video_stream");
+
+    std::string record_file_path = Config::read<std::string>("tello_stream_record_file");
+    if (record_file_path.empty())
+        return url;
+
+    // recorder takes Tello's port and forwards to decoder
+    size_t colon = url.rfind(':');
+    int listen_port = colon != std::string::npos ? std::atoi(url.c_str() + colon + 1) : 0;
+    listen_port = listen_port > 0 ? listen_port : 11111;
+    int forward_port = Config::read<int>("tello_stream_forward_port");
+    forward_port = forward_port > 0 ? forward_port : 11112;
+
+    stream_recorder_ = std::make_shared<Stream_Recorder>(listen_port, forward_port);
+    if (!stream_recorder_->start(record_file_path))
+    {
+        std::cerr << "ERROR: stream recorder failed, not recording\n";
+        stream_recorder_ = nullptr;
+        return url;
+    }
+
+    return stream_recorder_->get_forward_url();
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::stop_frame_source()
+{
+    frame_source_->stop();
+
+    if (stream_recorder_ != nullptr)
+    {
+        stream_recorder_->stop();
+        stream_recorder_ = nullptr;
+    }
+}
+
+// main =======================================================================
+bool ArUco_Detector::run_serial(const bool& data_collection)
+{
+    Frame frame;
+    Detection_Result result;
+    result.reserve(max_num_markers_);
+
+    // port ///////////////////////////////////////////////////////////////////
+    if (!start_frame_source())
+    {
+        return false;
+    }
+    begin_session();
 
     // data collection ========================================================
-    ofstream_.open(csv_file_name_);
-    
+    if (data_collection)
+        open_pose_log();
+
     ///////////////////////////////////////////////////////////////////////////
     for (;;)
-    {    
-        cap >> image;
-
-        // get timestamp
-        auto now = std::chrono::system_clock::now();
-        auto t = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch());
-        t_ = t.count();
-
-        // check frame
-        if (image.empty()) 
+    {
+        // pull newest frame
+        if (!frame_source_->get_latest_frame(frame))
         {
             std::cerr << "ERROR: blank frame\n";
             break;
         }
-        
+        t_ = frame.t_ms;
+        frame.timing.t_pulled = Clock::now();
+
         // pre-processing /////////////////////////////////////////////////////
         // convert to grayscale
-        cv::cvtColor(image, image, cv::COLOR_BGR2GRAY);
-
-        // --------------------------------------------------------------------
-        // convert to BGR for output
-        cv::cvtColor(image, image_out, cv::COLOR_GRAY2BGR);
-        // --------------------------------------------------------------------
+        cv::cvtColor(frame.image, image_, cv::COLOR_BGR2GRAY);
+        frame.timing.t_grayscale = Clock::now();
 
         // main ///////////////////////////////////////////////////////////////
-        // detect =============================================================      
-        std::vector<int> ids;
-        std::vector<std::vector<cv::Point2f>> p2Dss_pixel, rejected_p2Dss_pixel;
-        detector_->detectMarkers(image, p2Dss_pixel, ids, rejected_p2Dss_pixel);
-
-        target_index = find_target_index(ids);
-        target_found_ = target_index >= 0;
-
-        // estimate pose ======================================================
-        if (target_found_)
-        {   
-            std::vector<cv::Point2f> p2Ds_pixel = p2Dss_pixel.at(target_index);
-
-            // solve initial pose guess with RANSAC
-            cv::solvePnPRansac(p3Ds_target_, p2Ds_pixel, 
-                cameraMatrix_, distCoeffs_, rvec, tvec, 
-                false, cv::SOLVEPNP_IPPE_SQUARE);
-
-            // output
-            ofstream_ << t_ << ',' << 
-                rvec[0] << ',' << rvec[1] << ',' << rvec[2] << ',' <<
-                tvec[0] << ',' << tvec[1] << ',' << tvec[2] << '\n';
-        }
+        detect_frame(image_, frame.timestamp, result);
+        frame.timing.t_detected = Clock::now();
 
-        // output /////////////////////////////////////////////////////////////
-        // draw ---------------------------------------------------------------
-        if (!ids.empty())
-        {
-            cv::aruco::drawDetectedMarkers(image_out, p2Dss_pixel, ids);
-        }
+        estimate_pose_frame(result);
+        frame.timing.t_posed = Clock::now();
+        target_found_ = result.target_found;
 
-        if (target_index >= 0)
+        // output /////////////////////////////////////////////////////////////
+        if (!output(image_, result, data_collection))
         {
-            cv::drawFrameAxes(image_out, cameraMatrix_, distCoeffs_, rvec, tvec, 0.1, 2);
+            break; // quit when 'esc' pressed
         }
+        frame.timing.t_output = Clock::now();
 
-        if (verbose_)
-        {
-            // std::cout << "system clock: " << std::ctime(&t) << ":" << millisecond.count() << std::endl;
-            std::cout << "t_: " << t_ << std::endl;
-            std::cout << "rvec: " << rvec << std::endl;
-            std::cout << "tvec: " << tvec << std::endl;
-        }
- 
-        // show ===============================================================
-        // resize
-        cv::resize(image_out, image_out, cv::Size(), resize_scale_factor_, resize_scale_factor_, cv::INTER_LINEAR);
-
-        // show
-        cv::imshow("ArUco Tracker", image_out);
-        int key = cv::waitKey(10);
-        if (key == 27)
+        count_frame(frame, result);
+        if (stop_requested())
         {
-            break; // quit when 'esc' pressed
+            break;
         }
     }
-    ofstream_.close();
-    std::cout << "END" << std::endl;
+    stop_frame_source();
 
-    return true;
-}
+    if (data_collection)
+        close_pose_log();
 
-// ----------------------------------------------------------------------------
-bool ArUco_Detector::run_for_data_collection_as_thread()
-{
-    std::cout << "[ArUco Detector] started running as thread." << std::endl;
-    thread_ = std::thread(&ArUco_Detector::run_for_data_collection, this);
+    end_session();
 
     return true;
 }
 
 // ----------------------------------------------------------------------------
-void ArUco_Detector::close()
+void ArUco_Detector::detect(const cv::Mat& image, Detection_Result& result) const
 {
-    thread_.join();
+    detect(*detector_, image, result);
 }
 
-// ============================================================================
-int ArUco_Detector::find_target_index(const std::vector<int>& ids) const
+void ArUco_Detector::detect(const cv::aruco::ArucoDetector& detector, 
+    const cv::Mat& image, Detection_Result& result) const
 {
-    auto iterator = std::find(ids.begin(), ids.end(), target_id_);
-    if(iterator != ids.end())
+    detector.detectMarkers(image, result.p2Dss_pixel, result.ids);
+
+    find_targets(result);
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::find_targets(Detection_Result& result) const
+{
+    result.target_index = find_target_index(result.ids);
+    result.target_found = result.target_index >= 0;
+    result.roi = cv::Rect();
+
+    // all targets, constant-time lookup per ID
+    result.target_indices.clear();
+    for (size_t i = 0; i < result.ids.size(); ++i)
     {
-        return iterator - ids.begin();
+        if (is_target(result.ids[i]))
+            result.target_indices.push_back(i);
+    }
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::detect_tiled(const cv::Mat& image, 
+    const float& marker_size, Detection_Result& result)
+{
+    // tile layout ============================================================
+    // a marker on a border is whole in one tile if the overlap holds its
+    // bounding box (up to side * sqrt(2) when rotated), with margin for growth
+    int overlap = tile_overlap_;
+    if (marker_size > 0)
+        overlap = std::max(overlap, (int)std::ceil(1.5 * std::sqrt(2.0) * marker_size));
+
+    if (image.size() != tiled_image_size_ || overlap != tiled_overlap_)
+    {
+        layout_tiles(image.size(), overlap);
+        tiled_image_size_ = image.size();
+        tiled_overlap_ = overlap;
+    }
+
+    // detect per tile in parallel ============================================
+    #pragma omp parallel for num_threads(num_detection_threads_) schedule(dynamic)
+    for (int i = 0; i < (int)tiles_.size(); ++i)
+    {
+        Tile& tile = tiles_[i];
+        tracking_detector_->detectMarkers(image(tile.rect), tile.p2Dss_pixel, tile.ids);
+
+        cv::Point2f offset(tile.rect.x, tile.rect.y);
+        for (std::vector<cv::Point2f>& p2Ds_pixel : tile.p2Dss_pixel)
+            for (cv::Point2f& p2D_pixel : p2Ds_pixel)
+                p2D_pixel += offset;
+    }
+
+    // merge, dropping markers seen twice in overlaps =========================
+    size_t num_markers = 0;
+    for (const Tile& tile : tiles_)
+    {
+        for (size_t j = 0; j < tile.ids.size(); ++j)
+        {
+            const std::vector<cv::Point2f>& p2Ds_pixel = tile.p2Dss_pixel[j];
+            cv::Point2f center = (p2Ds_pixel[0] + p2Ds_pixel[2]) * 0.5f;
+            float half_diagonal = cv::norm(p2Ds_pixel[2] - p2Ds_pixel[0]) * 0.5f;
+
+            bool duplicate = false;
+            for (size_t k = 0; k < num_markers && !duplicate; ++k)
+            {
+                const std::vector<cv::Point2f>& kept = result.p2Dss_pixel[k];
+                duplicate = result.ids[k] == tile.ids[j] &&
+                    cv::norm((kept[0] + kept[2]) * 0.5f - center) < half_diagonal;
+            }
+            if (duplicate)
+                continue;
+
+            // copy into kept storage without reallocating inner vectors
+            if (num_markers == result.ids.size())
+            {
+                result.ids.push_back(tile.ids[j]);
+                result.p2Dss_pixel.push_back(p2Ds_pixel);
+            }
+            else
+            {
+                result.ids[num_markers] = tile.ids[j];
+                result.p2Dss_pixel[num_markers].assign(p2Ds_pixel.begin(), p2Ds_pixel.end());
+            }
+            ++num_markers;
+        }
+    }
+    result.ids.resize(num_markers);
+    result.p2Dss_pixel.resize(num_markers);
+
+    find_targets(result);
+
+    // size unknown: target may be larger than overlap and cut in every tile
+    if (marker_size <= 0 && !result.target_found)
+        detect(*tracking_detector_, image, result);
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::layout_tiles(const cv::Size& image_size, const int& overlap)
+{
+    // about one tile per thread, roughly square tiles
+    int num_tiles = std::max(num_detection_threads_, 1);
+    double aspect_ratio = (double)image_size.width / image_size.height;
+    int num_columns = std::max(1, (int)std::round(std::sqrt(num_tiles * aspect_ratio)));
+    num_columns = std::min(num_columns, num_tiles);
+    int num_rows = (num_tiles + num_columns - 1) / num_columns;
+
+    int tile_width  = (image_size.width  + num_columns - 1) / num_columns;
+    int tile_height = (image_size.height + num_rows - 1) / num_rows;
+
+    tiles_.resize(num_columns * num_rows);
+    for (int row = 0; row < num_rows; ++row)
+    {
+        for (int column = 0; column < num_columns; ++column)
+        {
+            int x0 = std::max(0, column * tile_width - overlap / 2);
+            int y0 = std::max(0, row * tile_height - overlap / 2);
+            int x1 = std::min(image_size.width,  (column + 1) * tile_width + overlap / 2);
+            int y1 = std::min(image_size.height, (row + 1) * tile_height + overlap / 2);
+
+            tiles_[row * num_columns + column].rect = cv::Rect(x0, y0, x1 - x0, y1 - y0);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::detect_tracked(const cv::Mat& image, Detection_Result& result)
+{
+    // follow corners of last frame ===========================================
+    if (corner_tracking_ && 
+        corner_tracker_.track(image, result.ids, result.p2Dss_pixel))
+    {
+        find_targets(result);
+        result.tracked = true;
+
+        if (roi_tracking_)
+        {
+            roi_tracker_.update(result.target_found ? 
+                &result.p2Dss_pixel.at(result.target_index) : nullptr, 
+                result.timestamp);
+        }
+        return;
+    }
+    result.tracked = false;
+
+    // where to search ========================================================
+    cv::Rect roi;
+    bool roi_found = roi_tracking_ && 
+        roi_tracker_.predict(image.size(), result.timestamp, roi);
+
+    // sub-image header, no copy
+    const cv::Mat search_image = roi_found ? image(roi) : image;
+
+    // at which scale to search ===============================================
+    int level = multi_scale_ ? select_pyramid_level() : 0;
+
+    // ROI is already small, tile only full-frame search
+    bool tiled = num_detection_threads_ > 1 && !roi_found;
+
+    if (adaptive_parameters_)
+        tune_detector_parameters(search_image.size(), level, tiled);
+
+    if (level == 0)
+    {
+        if (tiled)
+            detect_tiled(search_image, expected_marker_size_, result);
+        else
+            detect(*tracking_detector_, search_image, result);
     }
     else
     {
-        return -1;
+        double scale = 1.0 / (1 << level);
+        cv::Size scaled_size(cvRound(search_image.cols * scale), cvRound(search_image.rows * scale));
+
+        // top-left of a buffer grown to largest size seen, 
+        // so ROIs changing size every frame do not reallocate
+        if (image_scaled_.cols < scaled_size.width || 
+            image_scaled_.rows < scaled_size.height || 
+            image_scaled_.type() != search_image.type())
+        {
+            image_scaled_.create(std::max(image_scaled_.rows, scaled_size.height), 
+                std::max(image_scaled_.cols, scaled_size.width), search_image.type());
+        }
+        cv::Mat image_scaled = image_scaled_(cv::Rect(0, 0, scaled_size.width, scaled_size.height));
+
+        cv::resize(search_image, image_scaled, scaled_size, 0, 0, cv::INTER_AREA);
+        if (tiled)
+            detect_tiled(image_scaled, expected_marker_size_ / (1 << level), result);
+        else
+            detect(*tracking_detector_, image_scaled, result);
+
+        // map back to native resolution (pixel centers)
+        float factor = 1 << level;
+        for (std::vector<cv::Point2f>& p2Ds_pixel : result.p2Dss_pixel)
+            for (cv::Point2f& p2D_pixel : p2Ds_pixel)
+                p2D_pixel = (p2D_pixel + cv::Point2f(0.5f, 0.5f)) * factor - cv::Point2f(0.5f, 0.5f);
+    }
+
+    if (roi_found)
+    {
+        result.roi = roi;
+
+        // map back to full frame
+        cv::Point2f offset(roi.x, roi.y);
+        for (std::vector<cv::Point2f>& p2Ds_pixel : result.p2Dss_pixel)
+            for (cv::Point2f& p2D_pixel : p2Ds_pixel)
+                p2D_pixel += offset;
+    }
+
+    // refine coarse corners on native resolution =============================
+    if (level > 0)
+    {
+        int half_window = (1 << level) + 1;
+        for (std::vector<cv::Point2f>& p2Ds_pixel : result.p2Dss_pixel)
+        {
+            cv::cornerSubPix(image, p2Ds_pixel, 
+                cv::Size(half_window, half_window), cv::Size(-1, -1), 
+                cv::TermCriteria(cv::TermCriteria::COUNT | cv::TermCriteria::EPS, 10, 0.01));
+        }
+    }
+
+    if (roi_tracking_)
+    {
+        roi_tracker_.update(result.target_found ? 
+            &result.p2Dss_pixel.at(result.target_index) : nullptr, 
+            result.timestamp);
+    }
+
+    if (corner_tracking_)
+    {
+        corner_tracker_.update(image, result.ids, result.p2Dss_pixel, 
+            result.target_indices);
+    }
+}
+
+// ----------------------------------------------------------------------------
+int ArUco_Detector::select_pyramid_level() const
+{
+    // apparent marker side from last pose, unknown if target was lost
+    float marker_size = expected_marker_size_;
+    if (marker_size <= 0)
+        return 0;
+
+    int level = 0;
+    while (level < pyramid_max_level_ && 
+        marker_size / (2 << level) >= pyramid_min_marker_size_)
+    {
+        ++level;
+    }
+
+    return level;
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::tune_detector_parameters(const cv::Size& search_size, 
+    const int& level, const bool& tiled)
+{
+    // apparent marker side in searched image
+    float marker_size = expected_marker_size_ / (1 << level);
+    int max_dimension = std::max(search_size.width, search_size.height) >> level;
+
+    // target lost: back to wide defaults =====================================
+    if (marker_size <= 0)
+    {
+        if (tuned_marker_size_ > 0)
+        {
+            tracking_detector_->setDetectorParameters(detector_parameters_);
+            tuned_marker_size_ = 0;
+        }
+        return;
+    }
+
+    // skip small changes, tuned range has margin =============================
+    if (tuned_marker_size_ > 0 && max_dimension == tuned_max_dimension_ &&
+        std::abs(marker_size / tuned_marker_size_ - 1) < adaptive_size_margin_ / 4)
+    {
+        return;
+    }
+
+    cv::aruco::DetectorParameters parameters = detector_parameters_;
+
+    // perimeter bounds, relative to largest side of searched image
+    float perimeter = 4 * marker_size;
+    parameters.minMarkerPerimeterRate = std::max(
+        perimeter * (1 - adaptive_size_margin_) / max_dimension, 0.01f);
+    if (!tiled)
+    {
+        // tiles are smaller than search image, an upper bound would reject
+        parameters.maxMarkerPerimeterRate = std::min(
+            perimeter * (1 + adaptive_size_margin_) / max_dimension, 4.0f);
+    }
+
+    // threshold windows from 2 to 4 cells of the marker grid
+    int num_cells = dictionary_.markerSize + 2 * parameters.markerBorderBits;
+    float cell_size = marker_size / num_cells;
+    int window_min = std::max(3, (int)(2 * cell_size) | 1);
+    int window_max = std::max(window_min, (int)(4 * cell_size) | 1);
+    parameters.adaptiveThreshWinSizeMin = window_min;
+    parameters.adaptiveThreshWinSizeMax = window_max;
+    parameters.adaptiveThreshWinSizeStep = std::max(2, window_max - window_min);
+
+    // only swaps parameter struct, no reallocation;
+    // shared detector_ keeps wide defaults for process_frame()
+    tracking_detector_->setDetectorParameters(parameters);
+    tuned_marker_size_ = marker_size;
+    tuned_max_dimension_ = max_dimension;
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::estimate_pose(Detection_Result& result, 
+    const std::vector<Pose_Prior>* pose_priors) const
+{
+    size_t num_targets = result.target_indices.size();
+    result.rvecs.resize(num_targets);
+    result.tvecs.resize(num_targets);
+    result.poses.resize(num_targets);
+    result.pose.valid = false;
+
+    if (num_targets == 0)
+        return;
+
+    // undistort corners of all targets by table lookup =======================
+    result.p2Ds_pixel_batch.clear();
+    for (const int& target_index : result.target_indices)
+    {
+        const std::vector<cv::Point2f>& p2Ds_pixel = result.p2Dss_pixel[target_index];
+        result.p2Ds_pixel_batch.insert(result.p2Ds_pixel_batch.end(), 
+            p2Ds_pixel.begin(), p2Ds_pixel.end());
+    }
+    camera_->undistort_points(result.p2Ds_pixel_batch, result.p2Ds_normalized_batch);
+
+    // solve per marker on normalized coordinates =============================
+    for (size_t i = 0; i < num_targets; ++i)
+    {
+        // header on batch, no copy
+        cv::Mat p2Ds_normalized(4, 1, CV_32FC2, &result.p2Ds_normalized_batch[4 * i]);
+
+        // last pose of same marker, if recent
+        const Pose_Prior* prior = nullptr;
+        if (pose_priors != nullptr)
+        {
+            const Pose_Prior& pose_prior = pose_priors->at(result.ids[result.target_indices[i]]);
+            if (pose_prior.valid && 
+                result.timestamp - pose_prior.timestamp < pose_prior_timeout_)
+            {
+                prior = &pose_prior;
+            }
+        }
+
+        pose_solver_->solve(p3Ds_target_, p2Ds_normalized, prior, 
+            result.rvecs[i], result.tvecs[i]);
+
+        Marker_Pose& pose = result.poses[i];
+        pose.set(result.ids[result.target_indices[i]], result.timestamp, 
+            result.rvecs[i], result.tvecs[i]);
+        pose.reprojection_error = compute_reprojection_error(
+            result.p2Dss_pixel[result.target_indices[i]], pose, result);
+
+        if (result.target_indices[i] == result.target_index)
+        {
+            result.rvec = result.rvecs[i];
+            result.tvec = result.tvecs[i];
+            result.pose = pose;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+double ArUco_Detector::compute_reprojection_error(
+    const std::vector<cv::Point2f>& p2Ds_pixel, 
+    const Marker_Pose& pose, Detection_Result& result) const
+{
+    Mat33 R_cm = pose.get_R_camera_marker();
+    for (int i = 0; i < 4; ++i)
+    {
+        const cv::Point3d& p3D = p3Ds_target_[i];
+        result.p3Ds_camera.row(i) = (R_cm * Vec3(p3D.x, p3D.y, p3D.z) + pose.t_cm).transpose();
+    }
+
+    camera_->project(result.p3Ds_camera, result.p2Ds_reprojected);
+
+    double sum = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        double du = result.p2Ds_reprojected(i, 0) - p2Ds_pixel[i].x;
+        double dv = result.p2Ds_reprojected(i, 1) - p2Ds_pixel[i].y;
+        sum += du * du + dv * dv;
+    }
+
+    return std::sqrt(sum / 4);
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::estimate_pose_tracked(Detection_Result& result)
+{
+    estimate_pose(result, &pose_priors_);
+
+    for (size_t i = 0; i < result.target_indices.size(); ++i)
+    {
+        Pose_Prior& pose_prior = pose_priors_[result.ids[result.target_indices[i]]];
+        pose_prior.rvec = result.rvecs[i];
+        pose_prior.tvec = result.tvecs[i];
+        pose_prior.timestamp = result.timestamp;
+        pose_prior.valid = true;
+    }
+
+    if (result.target_found)
+    {
+        std::lock_guard<std::mutex> lock(latest_pose_mutex_);
+        latest_pose_ = result.pose;
+    }
+
+    if (pose_filter_ && result.target_found)
+        pose_filter_->add_vision(result.pose);
+
+    // expected marker side for next frame: f * L / z
+    if (result.target_found && result.tvec[2] > 0)
+        expected_marker_size_ = camera_->fx_ * marker_length_ / result.tvec[2];
+    else
+        expected_marker_size_ = 0;
+}
+
+// ----------------------------------------------------------------------------
+bool ArUco_Detector::output(const cv::Mat& image, 
+    const Detection_Result& result, const bool& data_collection)
+{
+    if (data_collection)
+    {
+        log_pose(result);
+
+        if (verbose_)
+        {
+            std::cout << "t_: " << t_ << std::endl;
+            std::cout << "rvec: " << result.rvec << std::endl;
+            std::cout << "tvec: " << result.tvec << std::endl;
+        }
+    }
+
+    if (headless_)
+        return true;
+
+    return render(image, result);
+}
+
+// data collection ============================================================
+void ArUco_Detector::open_pose_log()
+{
+    if (!binary_pose_log_)
+    {
+        ofstream_.open(csv_file_name_);
+        return;
+    }
+
+    if (pose_logger_ == nullptr)
+        pose_logger_ = std::make_shared<Pose_Logger>();
+    pose_logger_->open(csv_file_name_ + ".bin");
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::close_pose_log()
+{
+    if (!binary_pose_log_)
+    {
+        ofstream_.close();
+        return;
+    }
+
+    pose_logger_->close();
+    std::cout << "logged poses: " << pose_logger_->get_num_logged() 
+              << ", dropped: " << pose_logger_->get_num_dropped() << std::endl;
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::log_pose(const Detection_Result& result)
+{
+    if (!binary_pose_log_)
+    {
+        write_pose(ofstream_, t_, result);
+        return;
+    }
+
+    if (!result.target_found)
+        return;
+
+    Pose_Record record;
+    record.t_ms = t_;
+    for (int i = 0; i < 3; ++i)
+    {
+        record.rvec[i] = result.rvec[i];
+        record.tvec[i] = result.tvec[i];
+    }
+    pose_logger_->log(record);
+}
+
+// session ====================================================================
+void ArUco_Detector::begin_session()
+{
+    stop_requested_ = false;
+    num_processed_frames_ = 0;
+    reset_tracking();
+    metrics_->reset();
+
+    // ESC key is not available without window
+    if (headless_)
+    {
+        signal_received = false;
+        previous_sigint_handler_ = std::signal(SIGINT, handle_signal);
+        previous_sigterm_handler_ = std::signal(SIGTERM, handle_signal);
+        std::cout << "[ArUco Detector] headless, stop with Ctrl+C." << std::endl;
+    }
+
+    if (!latency_file_name_.empty())
+    {
+        latency_stream_.open(latency_file_name_);
+        latency_stream_ << "index,t_ms,pts_ms,decode_ms,retrieve_ms,queue_ms,"
+            "grayscale_ms,detect_ms,pose_ms,output_ms,total_ms\n";
+    }
+
+    t_session_start_ = Clock::now();
+    t_last_report_ = t_session_start_;
+    num_frames_at_last_report_ = 0;
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::end_session()
+{
+    double elapsed = std::chrono::duration<double>(Clock::now() - t_session_start_).count();
+    fps_ = elapsed > 0 ? num_processed_frames_ / elapsed : 0;
+
+    if (headless_)
+    {
+        std::signal(SIGINT, previous_sigint_handler_);
+        std::signal(SIGTERM, previous_sigterm_handler_);
+    }
+
+    std::cout << "processed frames: " << num_processed_frames_ 
+              << ", average FPS: " << fps_ << std::endl;
+    std::cout << "dropped frames: " << get_num_dropped_frames() << std::endl;
+
+    // latency breakdown ======================================================
+    if (latency_stream_.is_open())
+        latency_stream_.close();
+
+    Metrics::Snapshot metrics = metrics_->snapshot();
+    std::cout << std::left << std::setw(14) << "latency [ms]" << std::right 
+              << std::setw(9) << "p50" << std::setw(9) << "p90" 
+              << std::setw(9) << "p99" << std::setw(9) << "max" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (int i = 0; i < Metrics::NUM_STAGES; ++i)
+    {
+        const Latency_Histogram::Snapshot& stage = metrics.stages[i];
+        if (stage.count == 0)
+            continue; // no frame got that far, e.g. stream ended at once
+
+        std::cout << "  " << std::left << std::setw(12) << Metrics::stage_names[i] << std::right 
+                  << std::setw(9) << stage.percentile(50) << std::setw(9) << stage.percentile(90) 
+                  << std::setw(9) << stage.percentile(99) << std::setw(9) << stage.max << std::endl;
+    }
+    std::cout << std::defaultfloat;
+    if (corner_tracking_)
+    {
+        std::cout << "tracked frames: " << corner_tracker_.get_num_tracked_frames() 
+                  << ", tracking failures: " << corner_tracker_.get_num_failures() << std::endl;
+    }
+    std::cout << "END" << std::endl;
+}
+
+// ----------------------------------------------------------------------------
+bool ArUco_Detector::stop_requested() const
+{
+    return stop_requested_ || (headless_ && signal_received);
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::count_frame(const Frame& frame, const Detection_Result& result)
+{
+    ++num_processed_frames_;
+
+    metrics_->record(frame.timing);
+    if (flight_recorder_ != nullptr)
+    {
+        for (const Marker_Pose& pose : result.poses)
+        {
+            if (pose.valid)
+                flight_recorder_->record_pose(frame.t_ms, pose);
+        }
+    }
+    if (latency_stream_.is_open())
+        write_latency(latency_stream_, frame);
+    metrics_->count(Metrics::DETECTIONS, result.ids.size());
+    if (result.target_found)
+        metrics_->count(Metrics::TARGET_HITS);
+
+    // report frame rate periodically, there is no window to look at
+    Timestamp now = Clock::now();
+    double elapsed = std::chrono::duration<double>(now - t_last_report_).count();
+    if (headless_ && elapsed >= 5.0)
+    {
+        fps_ = (num_processed_frames_ - num_frames_at_last_report_) / elapsed;
+        std::cout << "[ArUco Detector] FPS: " << fps_ << std::endl;
+
+        t_last_report_ = now;
+        num_frames_at_last_report_ = num_processed_frames_;
+    }
+}
+
+// ----------------------------------------------------------------------------
+bool ArUco_Detector::render(const cv::Mat& image, const Detection_Result& result)
+{
+    draw(image, result);
+
+    // show ===================================================================
+    // resize (not in place, so neither buffer is reallocated)
+    cv::resize(image_out_, image_show_, cv::Size(), resize_scale_factor_, resize_scale_factor_, cv::INTER_LINEAR);
+
+    // show
+    cv::imshow("ArUco Tracker", image_show_);
+    int key = cv::waitKey(10);
+
+    return key != 27;
+}
+
+// ----------------------------------------------------------------------------
+const cv::Mat& ArUco_Detector::draw(const cv::Mat& image, const Detection_Result& result)
+{
+    // convert to BGR for output
+    if (rectify_display_)
+    {
+        camera_->rectify(image, image_rectified_);
+        cv::cvtColor(image_rectified_, image_out_, cv::COLOR_GRAY2BGR);
+
+        // corners to rectified pixels
+        p2Dss_rectified_.resize(result.p2Dss_pixel.size());
+        for (size_t i = 0; i < result.p2Dss_pixel.size(); ++i)
+        {
+            camera_->undistort_points(result.p2Dss_pixel[i], p2Dss_rectified_[i]);
+            for (cv::Point2f& p2D : p2Dss_rectified_[i])
+                p2D = cv::Point2f(camera_->fx_ * p2D.x + camera_->cx_, camera_->fy_ * p2D.y + camera_->cy_);
+        }
+    }
+    else
+    {
+        cv::cvtColor(image, image_out_, cv::COLOR_GRAY2BGR);
+    }
+    const std::vector<std::vector<cv::Point2f>>& p2Dss_drawn = 
+        rectify_display_ ? p2Dss_rectified_ : result.p2Dss_pixel;
+
+    // draw -------------------------------------------------------------------
+    if (!result.roi.empty())
+    {
+        cv::rectangle(image_out_, result.roi, cv::Scalar(255, 0, 0), 1);
+    }
+
+    if (!result.ids.empty())
+    {
+        cv::aruco::drawDetectedMarkers(image_out_, p2Dss_drawn, result.ids);
+    }
+
+    // axes through camera model, cv::drawFrameAxes knows Brown-Conrady only
+    for (size_t i = 0; i < result.target_indices.size(); ++i)
+    {
+        cv::Matx33d R;
+        cv::Rodrigues(result.rvecs[i], R);
+        const cv::Vec3d& t = result.tvecs[i];
+
+        // origin, x, y, z tips [m]
+        for (int j = 0; j < 4; ++j)
+        {
+            cv::Vec3d p3D(j == 1 ? 0.1 : 0, j == 2 ? 0.1 : 0, j == 3 ? 0.1 : 0);
+            cv::Vec3d p3D_camera = R * p3D + t;
+            p3Ds_axes_(j, 0) = p3D_camera[0];
+            p3Ds_axes_(j, 1) = p3D_camera[1];
+            p3Ds_axes_(j, 2) = p3D_camera[2];
+        }
+
+        if (rectify_display_)
+            camera_->Camera::project(p3Ds_axes_, p2Ds_axes_); // no distortion
+        else
+            camera_->project(p3Ds_axes_, p2Ds_axes_);
+
+        cv::Point2f origin(p2Ds_axes_(0, 0), p2Ds_axes_(0, 1));
+        const cv::Scalar colors[3] = {cv::Scalar(0, 0, 255), cv::Scalar(0, 255, 0), cv::Scalar(255, 0, 0)};
+        for (int j = 1; j < 4; ++j)
+        {
+            cv::line(image_out_, origin, 
+                cv::Point2f(p2Ds_axes_(j, 0), p2Ds_axes_(j, 1)), colors[j - 1], 2);
+        }
+    }
+
+    return image_out_;
+}
+
+// pipeline ===================================================================
+bool ArUco_Detector::run_pipeline(const bool& data_collection)
+{
+    // port ///////////////////////////////////////////////////////////////////
+    if (!start_frame_source())
+    {
+        return false;
+    }
+    begin_session();
+
+    // stages /////////////////////////////////////////////////////////////////
+    Packet_Queue captured_queue(pipeline_queue_size_, backpressure_policy_);
+    Packet_Queue detected_queue(pipeline_queue_size_, backpressure_policy_);
+    Packet_Queue estimated_queue(pipeline_queue_size_, backpressure_policy_);
+
+    std::thread capture_thread(&ArUco_Detector::capture_stage, this,
+        std::ref(captured_queue));
+    std::thread detect_thread(&ArUco_Detector::detect_stage, this,
+        std::ref(captured_queue), std::ref(detected_queue));
+    std::thread pose_thread(&ArUco_Detector::pose_stage, this,
+        std::ref(detected_queue), std::ref(estimated_queue));
+    std::cout << "[ArUco Detector] pipeline started." << std::endl;
+
+    // data collection ========================================================
+    if (data_collection)
+        open_pose_log();
+
+    // sink ///////////////////////////////////////////////////////////////////
+    Packet packet;
+    packet.result.reserve(max_num_markers_);
+    long num_dropped_in_queues = 0;
+    while (estimated_queue.pop(packet))
+    {
+        t_ = packet.frame.t_ms;
+        target_found_ = packet.result.target_found;
+
+        if (!output(packet.image, packet.result, data_collection))
+        {
+            break; // quit when 'esc' pressed
+        }
+        packet.frame.timing.t_output = Clock::now();
+
+        // queues count their own drops, forward only what is new
+        long num_dropped = captured_queue.get_num_dropped() + 
+            detected_queue.get_num_dropped() + estimated_queue.get_num_dropped();
+        if (num_dropped > num_dropped_in_queues)
+        {
+            metrics_->count(Metrics::FRAMES_DROPPED, num_dropped - num_dropped_in_queues);
+            num_dropped_in_queues = num_dropped;
+        }
+
+        count_frame(packet.frame, packet.result);
+        if (stop_requested())
+        {
+            break;
+        }
+    }
+
+    // shut down upstream first so no stage waits on a full queue
+    stop_frame_source();
+    captured_queue.close();
+    detected_queue.close();
+    estimated_queue.close();
+
+    capture_thread.join();
+    detect_thread.join();
+    pose_thread.join();
+
+    if (data_collection)
+        close_pose_log();
+
+    std::cout << "dropped frames in queues: " << captured_queue.get_num_dropped() 
+              << ", " << detected_queue.get_num_dropped() 
+              << ", " << estimated_queue.get_num_dropped() << std::endl;
+    end_session();
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::capture_stage(Packet_Queue& output_queue)
+{
+    Packet packet;
+    packet.result.reserve(max_num_markers_);
+    while (frame_source_->get_latest_frame(packet.frame))
+    {
+        packet.frame.timing.t_pulled = Clock::now();
+
+        // pre-processing: convert to grayscale
+        cv::cvtColor(packet.frame.image, packet.image, cv::COLOR_BGR2GRAY);
+        packet.frame.timing.t_grayscale = Clock::now();
+
+        if (!output_queue.push(packet))
+            break;
+    }
+    output_queue.close();
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::detect_stage(Packet_Queue& input_queue, Packet_Queue& output_queue)
+{
+    Packet packet;
+    packet.result.reserve(max_num_markers_);
+    while (input_queue.pop(packet))
+    {
+        packet.result.timestamp = packet.frame.timestamp;
+        detect_tracked(packet.image, packet.result);
+        packet.frame.timing.t_detected = Clock::now();
+
+        if (!output_queue.push(packet))
+            break;
+    }
+    output_queue.close();
+}
+
+// ----------------------------------------------------------------------------
+void ArUco_Detector::pose_stage(Packet_Queue& input_queue, Packet_Queue& output_queue)
+{
+    Packet packet;
+    packet.result.reserve(max_num_markers_);
+    while (input_queue.pop(packet))
+    {
+        estimate_pose_tracked(packet.result);
+        packet.frame.timing.t_posed = Clock::now();
+
+        if (!output_queue.push(packet))
+            break;
     }
+    output_queue.close();
 }
 
 } // namespace tello_basic
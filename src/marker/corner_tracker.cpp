@@ -0,0 +1,148 @@
+// corner_tracker.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include "marker/corner_tracker.h"
+
+
+namespace tello_basic
+{
+
+// public XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// constructor & destructor ///////////////////////////////////////////////////
+Corner_Tracker::Corner_Tracker(const int& detection_interval, 
+    const float& max_forward_backward_error, const float& max_area_change,
+    const int& window_size, const int& max_level)
+    : detection_interval_(detection_interval), 
+      max_forward_backward_error_(max_forward_backward_error), 
+      max_area_change_(max_area_change),
+      window_size_(window_size, window_size), max_level_(max_level) {}
+
+// member methods /////////////////////////////////////////////////////////////
+bool Corner_Tracker::track(const cv::Mat& image, std::vector<int>& ids, 
+    std::vector<std::vector<cv::Point2f>>& p2Dss_pixel)
+{
+    // periodic full detection catches new markers and resets drift
+    if (ids_.empty() || num_frames_since_detection_ + 1 >= detection_interval_)
+        return false;
+
+    // forward and backward flow ==============================================
+    cv::buildOpticalFlowPyramid(image, pyramid_current_, window_size_, max_level_,
+        true, cv::BORDER_REFLECT_101, cv::BORDER_CONSTANT, false);
+
+    cv::TermCriteria criteria(cv::TermCriteria::COUNT | cv::TermCriteria::EPS, 20, 0.03);
+    cv::calcOpticalFlowPyrLK(pyramid_previous_, pyramid_current_, 
+        p2Ds_previous_, p2Ds_current_, status_forward_, errors_, 
+        window_size_, max_level_, criteria);
+    cv::calcOpticalFlowPyrLK(pyramid_current_, pyramid_previous_, 
+        p2Ds_current_, p2Ds_backward_, status_backward_, errors_, 
+        window_size_, max_level_, criteria);
+
+    // verify every marker ====================================================
+    for (size_t i = 0; i < ids_.size(); ++i)
+    {
+        if (!is_consistent(i, image.size()))
+        {
+            ++num_failures_;
+            return false;
+        }
+    }
+
+    // output =================================================================
+    ids.assign(ids_.begin(), ids_.end());
+    p2Dss_pixel.resize(ids_.size());
+    for (size_t i = 0; i < ids_.size(); ++i)
+    {
+        p2Dss_pixel[i].assign(p2Ds_current_.begin() + 4 * i, 
+            p2Ds_current_.begin() + 4 * (i + 1));
+    }
+
+    // current frame is reference for next one
+    std::swap(pyramid_previous_, pyramid_current_);
+    std::swap(p2Ds_previous_, p2Ds_current_);
+    ++num_frames_since_detection_;
+    ++num_tracked_frames_;
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+void Corner_Tracker::update(const cv::Mat& image, const std::vector<int>& ids, 
+    const std::vector<std::vector<cv::Point2f>>& p2Dss_pixel, 
+    const std::vector<int>& target_indices)
+{
+    ids_.clear();
+    p2Ds_previous_.clear();
+    num_frames_since_detection_ = 0;
+
+    if (target_indices.empty())
+        return;
+
+    for (const int& target_index : target_indices)
+    {
+        ids_.push_back(ids[target_index]);
+        p2Ds_previous_.insert(p2Ds_previous_.end(), 
+            p2Dss_pixel[target_index].begin(), p2Dss_pixel[target_index].end());
+    }
+
+    // own copy, caller reuses image buffer
+    cv::buildOpticalFlowPyramid(image, pyramid_previous_, window_size_, max_level_,
+        true, cv::BORDER_REFLECT_101, cv::BORDER_CONSTANT, false);
+}
+
+// ----------------------------------------------------------------------------
+void Corner_Tracker::reset()
+{
+    ids_.clear();
+    p2Ds_previous_.clear();
+    num_frames_since_detection_ = 0;
+    num_tracked_frames_ = 0;
+    num_failures_ = 0;
+}
+
+// private XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// member methods /////////////////////////////////////////////////////////////
+bool Corner_Tracker::is_consistent(const size_t& i, const cv::Size& image_size) const
+{
+    // forward-backward error per corner ======================================
+    for (size_t j = 4 * i; j < 4 * (i + 1); ++j)
+    {
+        if (!status_forward_[j] || !status_backward_[j])
+            return false;
+
+        if (cv::norm(p2Ds_backward_[j] - p2Ds_previous_[j]) > max_forward_backward_error_)
+            return false;
+
+        const cv::Point2f& p2D = p2Ds_current_[j];
+        if (p2D.x < 0 || p2D.y < 0 || 
+            p2D.x > image_size.width - 1 || p2D.y > image_size.height - 1)
+            return false;
+    }
+
+    // marker shape ===========================================================
+    // headers on corner buffers, no copy
+    cv::Mat quadrilateral_previous(4, 1, CV_32FC2, 
+        const_cast<cv::Point2f*>(&p2Ds_previous_[4 * i]));
+    cv::Mat quadrilateral_current(4, 1, CV_32FC2, 
+        const_cast<cv::Point2f*>(&p2Ds_current_[4 * i]));
+
+    if (!cv::isContourConvex(quadrilateral_current))
+        return false;
+
+    double area_previous = cv::contourArea(quadrilateral_previous);
+    double area_current = cv::contourArea(quadrilateral_current);
+
+    return area_previous > 0 && 
+        std::abs(area_current / area_previous - 1) <= max_area_change_;
+}
+
+} // namespace tello_basic
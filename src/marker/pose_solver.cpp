@@ -0,0 +1,107 @@
+// pose_solver.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference: OpenCV solvePnPGeneric, IPPE (Collins & Bartoli 2014)
+
+
+#include "marker/pose_solver.h"
+
+
+namespace tello_basic
+{
+
+// rotation angle between two Rodrigues vectors [rad]
+static double rotation_distance(const cv::Vec3d& rvec0, const cv::Vec3d& rvec1)
+{
+    cv::Matx33d R0, R1;
+    cv::Rodrigues(rvec0, R0);
+    cv::Rodrigues(rvec1, R1);
+
+    cv::Matx33d R = R0.t() * R1;
+    double cos_angle = (R(0, 0) + R(1, 1) + R(2, 2) - 1) / 2;
+
+    return std::acos(std::min(1.0, std::max(-1.0, cos_angle)));
+}
+
+// Pose_Solver XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+Pose_Solver::Ptr Pose_Solver::create(const std::string& solver_name)
+{
+    if (solver_name == "ippe_square")
+        return std::make_shared<IPPE_Square_Solver>();
+    else if (solver_name == "iterative")
+        return std::make_shared<Iterative_Solver>();
+    else if (solver_name == "ippe_disambiguated")
+        return std::make_shared<IPPE_Disambiguated_Solver>();
+
+    return nullptr;
+}
+
+// IPPE_Square_Solver XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+void IPPE_Square_Solver::solve(const std::vector<cv::Point3d>& p3Ds_target, 
+    const cv::Mat& p2Ds_normalized, const Pose_Prior* prior, 
+    cv::Vec3d& rvec, cv::Vec3d& tvec) const
+{
+    cv::solvePnP(p3Ds_target, p2Ds_normalized, 
+        cv::Matx33d::eye(), cv::noArray(), rvec, tvec, 
+        false, cv::SOLVEPNP_IPPE_SQUARE);
+}
+
+// Iterative_Solver XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+void Iterative_Solver::solve(const std::vector<cv::Point3d>& p3Ds_target, 
+    const cv::Mat& p2Ds_normalized, const Pose_Prior* prior, 
+    cv::Vec3d& rvec, cv::Vec3d& tvec) const
+{
+    if (prior == nullptr)
+    {
+        cv::solvePnP(p3Ds_target, p2Ds_normalized, 
+            cv::Matx33d::eye(), cv::noArray(), rvec, tvec, 
+            false, cv::SOLVEPNP_IPPE_SQUARE);
+    }
+    else
+    {
+        // warm start, marker barely moves between frames
+        rvec = prior->rvec;
+        tvec = prior->tvec;
+    }
+
+    cv::solvePnPRefineLM(p3Ds_target, p2Ds_normalized, 
+        cv::Matx33d::eye(), cv::noArray(), rvec, tvec, 
+        cv::TermCriteria(cv::TermCriteria::COUNT | cv::TermCriteria::EPS, 10, 1e-10));
+}
+
+// IPPE_Disambiguated_Solver XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+void IPPE_Disambiguated_Solver::solve(const std::vector<cv::Point3d>& p3Ds_target, 
+    const cv::Mat& p2Ds_normalized, const Pose_Prior* prior, 
+    cv::Vec3d& rvec, cv::Vec3d& tvec) const
+{
+    // both solutions, sorted by reprojection error
+    std::vector<cv::Vec3d> rvecs, tvecs;
+    std::vector<double> reprojection_errors;
+    int num_solutions = cv::solvePnPGeneric(p3Ds_target, p2Ds_normalized, 
+        cv::Matx33d::eye(), cv::noArray(), rvecs, tvecs, 
+        false, cv::SOLVEPNP_IPPE_SQUARE, cv::noArray(), cv::noArray(), 
+        reprojection_errors);
+
+    if (num_solutions == 0)
+        return;
+
+    int best = 0;
+    if (prior != nullptr && num_solutions > 1 &&
+        reprojection_errors[1] <= max_error_ratio_ * reprojection_errors[0] &&
+        rotation_distance(rvecs[1], prior->rvec) < rotation_distance(rvecs[0], prior->rvec))
+    {
+        best = 1;
+    }
+
+    rvec = rvecs[best];
+    tvec = tvecs[best];
+}
+
+} // namespace tello_basic
@@ -0,0 +1,100 @@
+// roi_tracker.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include "marker/roi_tracker.h"
+
+
+namespace tello_basic
+{
+
+// public XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// constructor & destructor ///////////////////////////////////////////////////
+ROI_Tracker::ROI_Tracker(const double& expansion, const int& max_num_misses)
+    : expansion_(expansion), max_num_misses_(max_num_misses) {}
+
+// member methods /////////////////////////////////////////////////////////////
+bool ROI_Tracker::predict(const cv::Size& image_size, 
+    const Timestamp& timestamp, cv::Rect& roi) const
+{
+    if (!tracking_)
+        return false;
+
+    // constant velocity motion
+    float dt = std::chrono::duration<float>(timestamp - t_last_).count();
+    cv::Point2f center = center_ + velocity_ * dt;
+
+    // grow with every miss, target may have moved further than predicted
+    float half_size = size_ * (0.5f + expansion_ * (1 + num_misses_));
+    half_size = std::max(half_size, 32.0f);
+
+    int x0 = std::max(0, (int)(center.x - half_size));
+    int y0 = std::max(0, (int)(center.y - half_size));
+    int x1 = std::min(image_size.width,  (int)(center.x + half_size));
+    int y1 = std::min(image_size.height, (int)(center.y + half_size));
+
+    if (x1 - x0 < 16 || y1 - y0 < 16)
+        return false; // predicted out of image
+
+    roi = cv::Rect(x0, y0, x1 - x0, y1 - y0);
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+void ROI_Tracker::update(const std::vector<cv::Point2f>* p2Ds_pixel, 
+    const Timestamp& timestamp)
+{
+    // miss ===================================================================
+    if (p2Ds_pixel == nullptr)
+    {
+        if (tracking_ && ++num_misses_ >= max_num_misses_)
+            reset(); // fall back to full-frame search
+
+        return;
+    }
+
+    // hit ====================================================================
+    float x_min = p2Ds_pixel->at(0).x, x_max = x_min;
+    float y_min = p2Ds_pixel->at(0).y, y_max = y_min;
+    for (const cv::Point2f& p2D_pixel : *p2Ds_pixel)
+    {
+        x_min = std::min(x_min, p2D_pixel.x);
+        x_max = std::max(x_max, p2D_pixel.x);
+        y_min = std::min(y_min, p2D_pixel.y);
+        y_max = std::max(y_max, p2D_pixel.y);
+    }
+    cv::Point2f center((x_min + x_max) / 2, (y_min + y_max) / 2);
+
+    float dt = std::chrono::duration<float>(timestamp - t_last_).count();
+    if (tracking_ && dt > 0)
+        velocity_ = (center - center_) * (1 / dt);
+    else
+        velocity_ = cv::Point2f(0, 0);
+
+    center_ = center;
+    size_ = std::max(x_max - x_min, y_max - y_min);
+    t_last_ = timestamp;
+
+    tracking_ = true;
+    num_misses_ = 0;
+}
+
+// ----------------------------------------------------------------------------
+void ROI_Tracker::reset()
+{
+    tracking_ = false;
+    num_misses_ = 0;
+    velocity_ = cv::Point2f(0, 0);
+}
+
+} // namespace tello_basic
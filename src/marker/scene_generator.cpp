@@ -0,0 +1,322 @@
+// scene_generator.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include <fstream>
+
+#include "marker/scene_generator.h"
+#include "port/config.h"
+
+
+namespace tello_basic
+{
+
+static void read_if_set(const std::string& parameter, double& value)
+{
+    cv::FileNode node = Config::read<cv::FileNode>(parameter);
+    if (!node.empty())
+        value = (double)node;
+}
+
+// ============================================================================
+void Scene_Options::read_config()
+{
+    double width = image_size.width, height = image_size.height;
+    read_if_set("synthetic_width", width);
+    read_if_set("synthetic_height", height);
+    image_size = cv::Size((int)width, (int)height);
+    read_if_set("synthetic_fps", fps);
+
+    double background_level = background, seed_value = (double)seed;
+    read_if_set("synthetic_background", background_level);
+    background = (int)background_level;
+    read_if_set("synthetic_gain", gain);
+    read_if_set("synthetic_bias", bias);
+    read_if_set("synthetic_gradient", gradient);
+    read_if_set("synthetic_blur_sigma", blur_sigma);
+    read_if_set("synthetic_noise_sigma", noise_sigma);
+
+    read_if_set("synthetic_distance_min", distance_min);
+    read_if_set("synthetic_distance_max", distance_max);
+    read_if_set("synthetic_max_tilt", max_tilt);
+    read_if_set("synthetic_period", period);
+    read_if_set("synthetic_seed", seed_value);
+    seed = (unsigned long long)seed_value;
+}
+
+// public XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// constructor & destructor ///////////////////////////////////////////////////
+Scene_Generator::Scene_Generator(const Camera::Ptr camera, 
+    const cv::aruco::Dictionary& dictionary, const double& marker_length, 
+    const std::vector<int>& ids, const Scene_Options& options)
+    : camera_(camera), marker_length_(marker_length), ids_(ids), 
+      options_(options), rng_(options.seed)
+{
+    // marker textures ========================================================
+    int marker_side = (dictionary.markerSize + 2) * texture_cell_size_;
+    int quiet_zone = quiet_zone_cells_ * texture_cell_size_;
+    texture_scale_ = marker_side / marker_length;
+
+    cv::Mat marker_image;
+    for (const int& id : ids_)
+    {
+        cv::aruco::generateImageMarker(dictionary, id, marker_side, marker_image, 1);
+
+        cv::Mat texture;
+        cv::copyMakeBorder(marker_image, texture, quiet_zone, quiet_zone, 
+            quiet_zone, quiet_zone, cv::BORDER_CONSTANT, cv::Scalar(255));
+        textures_.push_back(texture);
+    }
+
+    // ray of every pixel, fixed for camera ===================================
+    const cv::Size& size = options_.image_size;
+    MatX2 p2Ds_pixel(size.width * size.height, 2);
+    for (int v = 0; v < size.height; ++v)
+    {
+        for (int u = 0; u < size.width; ++u)
+        {
+            p2Ds_pixel(v * size.width + u, 0) = u;
+            p2Ds_pixel(v * size.width + u, 1) = v;
+        }
+    }
+    camera_->unproject(p2Ds_pixel, rays_);
+
+    s_.resize(size.width);
+    mx_.resize(size.width);
+    my_.resize(size.width);
+
+    // buffers ================================================================
+    image_gray_.create(size, CV_8UC1);
+    map_x_.create(size, CV_32FC1);
+    map_y_.create(size, CV_32FC1);
+    noise_.create(size, CV_32FC1);
+
+    // lighting: horizontal brightness ramp
+    gradient_map_.create(size, CV_32FC1);
+    for (int v = 0; v < size.height; ++v)
+    {
+        float* row = gradient_map_.ptr<float>(v);
+        for (int u = 0; u < size.width; ++u)
+            row[u] = options_.gain * (1 + options_.gradient * ((double)u / (size.width - 1) - 0.5));
+    }
+
+    t_start_ = Clock::now();
+}
+
+// member methods /////////////////////////////////////////////////////////////
+void Scene_Generator::next_frame(Synthetic_Frame& frame)
+{
+    double t = num_frames_ / options_.fps;
+
+    // markers side by side along board x ====================================
+    Marker_Pose board = get_board_pose(t);
+    std::vector<Marker_Pose> poses(ids_.size(), board);
+    for (size_t i = 0; i < ids_.size(); ++i)
+    {
+        Vec3 offset((i - 0.5 * (ids_.size() - 1)) * 1.5 * marker_length_, 0, 0);
+        poses[i].t_cm = board.t_cm + board.q_cm * offset;
+    }
+
+    frame.index = num_frames_;
+    frame.timestamp = t_start_ + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(t));
+    for (Marker_Pose& pose : poses)
+        pose.timestamp = frame.timestamp;
+
+    render(poses, frame);
+    ++num_frames_;
+}
+
+// ----------------------------------------------------------------------------
+void Scene_Generator::render(const std::vector<Marker_Pose>& poses, 
+    Synthetic_Frame& frame)
+{
+    // markers ================================================================
+    image_gray_.setTo(cv::Scalar(options_.background));
+
+    frame.ids = ids_;
+    frame.poses = poses;
+    frame.p2Dss_pixel.resize(ids_.size());
+    for (size_t i = 0; i < ids_.size(); ++i)
+    {
+        frame.poses[i].id = ids_[i];
+        render_marker(textures_[i], poses[i]);
+
+        if (!project_corners(poses[i], marker_length_ / 2, frame.p2Dss_pixel[i]))
+            frame.p2Dss_pixel[i].clear(); // behind camera
+    }
+
+    // lighting, blur, noise ==================================================
+    image_gray_.convertTo(image_float_, CV_32F);
+    cv::multiply(image_float_, gradient_map_, image_float_);
+    cv::add(image_float_, cv::Scalar(options_.bias), image_float_);
+
+    if (options_.blur_sigma > 0)
+        cv::GaussianBlur(image_float_, image_float_, cv::Size(0, 0), options_.blur_sigma);
+
+    if (options_.noise_sigma > 0)
+    {
+        rng_.fill(noise_, cv::RNG::NORMAL, 0, options_.noise_sigma);
+        cv::add(image_float_, noise_, image_float_);
+    }
+
+    image_float_.convertTo(image_gray_, CV_8U); // saturates
+    cv::cvtColor(image_gray_, frame.image, cv::COLOR_GRAY2BGR);
+}
+
+// ----------------------------------------------------------------------------
+bool Scene_Generator::write_video(const std::string& video_file_path, 
+    const std::string& ground_truth_file_path, const long& num_frames)
+{
+    cv::VideoWriter video_writer(video_file_path, 
+        cv::VideoWriter::fourcc('M', 'J', 'P', 'G'), options_.fps, options_.image_size);
+    std::ofstream ground_truth(ground_truth_file_path);
+    if (!video_writer.isOpened() || !ground_truth.is_open())
+    {
+        std::cout << "ERROR: could not open " << video_file_path 
+                  << " or " << ground_truth_file_path << std::endl;
+        return false;
+    }
+
+    ground_truth << "frame,id,qw,qx,qy,qz,tx,ty,tz,u0,v0,u1,v1,u2,v2,u3,v3\n";
+
+    Synthetic_Frame frame;
+    for (long i = 0; i < num_frames; ++i)
+    {
+        next_frame(frame);
+        video_writer.write(frame.image);
+
+        for (size_t j = 0; j < frame.ids.size(); ++j)
+        {
+            const Marker_Pose& pose = frame.poses[j];
+            ground_truth << frame.index << ',' << frame.ids[j] << ',' 
+                << pose.q_cm.w() << ',' << pose.q_cm.x() << ',' 
+                << pose.q_cm.y() << ',' << pose.q_cm.z() << ',' 
+                << pose.t_cm[0] << ',' << pose.t_cm[1] << ',' << pose.t_cm[2];
+            for (const cv::Point2f& p2D_pixel : frame.p2Dss_pixel[j])
+                ground_truth << ',' << p2D_pixel.x << ',' << p2D_pixel.y;
+            ground_truth << '\n';
+        }
+    }
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+Marker_Pose Scene_Generator::get_board_pose(const double& t) const
+{
+    // incommensurate frequencies, so poses do not repeat quickly
+    double phase = 2 * CV_PI * t / options_.period;
+
+    double distance_mid = (options_.distance_min + options_.distance_max) / 2;
+    double distance_amplitude = (options_.distance_max - options_.distance_min) / 2;
+    double distance = distance_mid + distance_amplitude * std::sin(phase);
+
+    // facing camera: marker x right, y up, z toward camera
+    Mat33 R_facing;
+    R_facing << 1,  0,  0,
+                0, -1,  0,
+                0,  0, -1;
+
+    Marker_Pose pose;
+    pose.q_cm = Quaternion(R_facing) * 
+        Eigen::AngleAxisd(options_.max_tilt * std::sin(2.3 * phase + 0.5), Vec3::UnitX()) *
+        Eigen::AngleAxisd(options_.max_tilt * std::sin(1.7 * phase), Vec3::UnitY()) *
+        Eigen::AngleAxisd(0.3 * std::sin(0.9 * phase), Vec3::UnitZ());
+    pose.t_cm = Vec3(0.2 * distance * std::sin(1.3 * phase), 
+        0.15 * distance * std::cos(1.1 * phase), distance);
+    pose.valid = true;
+
+    return pose;
+}
+
+// private XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// member methods /////////////////////////////////////////////////////////////
+void Scene_Generator::render_marker(const cv::Mat& texture, const Marker_Pose& pose)
+{
+    // region covered by marker and quiet zone ================================
+    double half_size = 0.5 * texture.cols / texture_scale_;
+    std::vector<cv::Point2f> p2Ds_pixel;
+    if (!project_corners(pose, half_size, p2Ds_pixel))
+        return;
+
+    cv::Rect bounding_box = cv::boundingRect(p2Ds_pixel);
+    int margin = 2 + bounding_box.width / 10; // edges bend under distortion
+    bounding_box = cv::Rect(bounding_box.x - margin, bounding_box.y - margin, 
+        bounding_box.width + 2 * margin, bounding_box.height + 2 * margin) & 
+        cv::Rect(0, 0, options_.image_size.width, options_.image_size.height);
+    if (bounding_box.empty())
+        return;
+
+    // pixel ray to marker plane to texture coordinates =======================
+    Mat33 R = pose.q_cm.toRotationMatrix();
+    Vec3 normal = R.col(2);
+    const Vec3& t = pose.t_cm;
+    double normal_t = normal.dot(t);
+    double center = 0.5 * texture.cols - 0.5; // pixel centers
+
+    int n = bounding_box.width;
+    for (int v = bounding_box.y; v < bounding_box.y + bounding_box.height; ++v)
+    {
+        Eigen::Index i0 = (Eigen::Index)v * options_.image_size.width + bounding_box.x;
+        auto dx = rays_.col(0).segment(i0, n).array();
+        auto dy = rays_.col(1).segment(i0, n).array();
+
+        // ray depth at plane, then point relative to marker origin
+        s_.head(n) = normal_t / (normal[0] * dx + normal[1] * dy + normal[2]);
+        mx_.head(n) = R(0, 0) * (s_.head(n) * dx - t[0]) + 
+            R(1, 0) * (s_.head(n) * dy - t[1]) + R(2, 0) * (s_.head(n) - t[2]);
+        my_.head(n) = R(0, 1) * (s_.head(n) * dx - t[0]) + 
+            R(1, 1) * (s_.head(n) * dy - t[1]) + R(2, 1) * (s_.head(n) - t[2]);
+
+        // texture rows grow downward, marker y upward; -1 leaves pixel as is
+        Eigen::Map<Eigen::ArrayXf>(map_x_.ptr<float>(v) + bounding_box.x, n) = 
+            (s_.head(n) > 0).select(mx_.head(n) * texture_scale_ + center, -1.0).cast<float>();
+        Eigen::Map<Eigen::ArrayXf>(map_y_.ptr<float>(v) + bounding_box.x, n) = 
+            (s_.head(n) > 0).select(-my_.head(n) * texture_scale_ + center, -1.0).cast<float>();
+    }
+
+    cv::Mat image_roi = image_gray_(bounding_box);
+    cv::remap(texture, image_roi, map_x_(bounding_box), map_y_(bounding_box), 
+        cv::INTER_LINEAR, cv::BORDER_TRANSPARENT);
+}
+
+// ----------------------------------------------------------------------------
+bool Scene_Generator::project_corners(const Marker_Pose& pose, 
+    const double& half_size, std::vector<cv::Point2f>& p2Ds_pixel) const
+{
+    // same order as ArUco_Detector target corners
+    const double corners[4][2] = 
+        {{-half_size, half_size}, {half_size, half_size}, 
+         {half_size, -half_size}, {-half_size, -half_size}};
+
+    MatX3 p3Ds_camera(4, 3);
+    for (int i = 0; i < 4; ++i)
+    {
+        Vec3 p3D_camera = pose.q_cm * Vec3(corners[i][0], corners[i][1], 0) + pose.t_cm;
+        if (p3D_camera[2] < 1e-3)
+            return false;
+
+        p3Ds_camera.row(i) = p3D_camera.transpose();
+    }
+
+    MatX2 p2Ds;
+    camera_->project(p3Ds_camera, p2Ds);
+
+    p2Ds_pixel.resize(4);
+    for (int i = 0; i < 4; ++i)
+        p2Ds_pixel[i] = cv::Point2f(p2Ds(i, 0), p2Ds(i, 1));
+
+    return true;
+}
+
+} // namespace tello_basic
@@ -0,0 +1,183 @@
+// flight_recorder.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference: mmap(2), msync(2)
+
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "port/flight_recorder.h"
+
+
+namespace tello_basic
+{
+
+// public XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// constructor & destructor ///////////////////////////////////////////////////
+Flight_Recorder::~Flight_Recorder()
+{
+    close();
+}
+
+// member methods /////////////////////////////////////////////////////////////
+bool Flight_Recorder::open(const std::string& file_path, const uint64_t& capacity)
+{
+    close();
+
+    capacity_ = capacity > 0 ? capacity : 1;
+    mapping_size_ = Flight_Recorder_Header::data_offset + capacity_ * sizeof(Flight_Record);
+
+    file_descriptor_ = ::open(file_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file_descriptor_ < 0)
+    {
+        std::cerr << "ERROR: could not create flight recorder " << file_path << std::endl;
+        return false;
+    }
+
+    // reserve blocks now, a full disk must not turn a later write into SIGBUS
+    if (posix_fallocate(file_descriptor_, 0, mapping_size_) != 0)
+    {
+        std::cerr << "ERROR: could not allocate flight recorder " << file_path << std::endl;
+        close();
+        return false;
+    }
+
+    mapping_ = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, 
+        file_descriptor_, 0);
+    if (mapping_ == MAP_FAILED)
+    {
+        mapping_ = nullptr;
+        std::cerr << "ERROR: could not map flight recorder " << file_path << std::endl;
+        close();
+        return false;
+    }
+
+    // file is zeroed, so every record starts incomplete (sequence 0)
+    Flight_Recorder_Header header;
+    header.capacity = capacity_;
+    header.t_created_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::memcpy(mapping_, &header, sizeof(header));
+
+    header_ = static_cast<Flight_Recorder_Header*>(mapping_);
+    records_ = reinterpret_cast<Flight_Record*>(
+        static_cast<char*>(mapping_) + Flight_Recorder_Header::data_offset);
+
+    std::cout << "[Flight Recorder] " << file_path << ", " << capacity_ << " records." << std::endl;
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+void Flight_Recorder::close()
+{
+    if (mapping_ != nullptr)
+    {
+        msync(mapping_, mapping_size_, MS_SYNC);
+        munmap(mapping_, mapping_size_);
+    }
+    if (file_descriptor_ >= 0)
+        ::close(file_descriptor_);
+
+    mapping_ = nullptr;
+    header_ = nullptr;
+    records_ = nullptr;
+    file_descriptor_ = -1;
+}
+
+// ----------------------------------------------------------------------------
+void Flight_Recorder::write(const Flight_Record& record)
+{
+    if (header_ == nullptr)
+        return;
+
+    // claim a slot; the cursor is the only shared state between writers
+    uint64_t index = __atomic_fetch_add(&header_->cursor, 1, __ATOMIC_RELAXED);
+    Flight_Record* slot = records_ + index % capacity_;
+
+    // mark incomplete, copy payload, then publish with its sequence.
+    // a record torn by a crash keeps sequence 0 and is skipped by read()
+    __atomic_store_n(&slot->sequence, 0, __ATOMIC_RELAXED);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(reinterpret_cast<char*>(slot) + sizeof(slot->sequence), 
+        reinterpret_cast<const char*>(&record) + sizeof(record.sequence), 
+        sizeof(Flight_Record) - sizeof(record.sequence));
+    __atomic_store_n(&slot->sequence, index + 1, __ATOMIC_RELEASE);
+}
+
+// ----------------------------------------------------------------------------
+void Flight_Recorder::record_pose(const long& t_ms, const Marker_Pose& pose)
+{
+    Flight_Record record;
+    record.t_ms = t_ms;
+    record.type = Flight_Record::POSE;
+    record.id = pose.id;
+    const double values[8] = {pose.q_cm.w(), pose.q_cm.x(), pose.q_cm.y(), pose.q_cm.z(), 
+        pose.t_cm[0], pose.t_cm[1], pose.t_cm[2], pose.reprojection_error};
+    std::memcpy(record.values, values, sizeof(values));
+
+    write(record);
+}
+
+// ----------------------------------------------------------------------------
+bool Flight_Recorder::read(const std::string& file_path, const double& duration, 
+    std::vector<Flight_Record>& records)
+{
+    std::ifstream stream(file_path, std::ios::binary);
+    if (!stream.is_open())
+    {
+        std::cerr << "ERROR: could not open flight recorder " << file_path << std::endl;
+        return false;
+    }
+
+    Flight_Recorder_Header header;
+    if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)) || !header.is_valid())
+    {
+        std::cerr << "ERROR: " << file_path << " is not a flight recorder file" << std::endl;
+        return false;
+    }
+
+    std::vector<Flight_Record> ring(header.capacity);
+    stream.seekg(Flight_Recorder_Header::data_offset);
+    stream.read(reinterpret_cast<char*>(ring.data()), ring.size() * sizeof(Flight_Record));
+    ring.resize(stream.gcount() / sizeof(Flight_Record)); // tolerate a truncated copy
+
+    // oldest first; a slot holds index i only if its sequence says so
+    records.clear();
+    uint64_t first = header.cursor > header.capacity ? header.cursor - header.capacity : 0;
+    for (uint64_t i = first; i < header.cursor; ++i)
+    {
+        uint64_t slot = i % header.capacity;
+        if (slot < ring.size() && ring[slot].sequence == i + 1)
+            records.push_back(ring[slot]);
+    }
+
+    if (duration > 0 && !records.empty())
+    {
+        int64_t t_newest = records.front().t_ms;
+        for (const Flight_Record& record : records)
+            t_newest = std::max(t_newest, record.t_ms);
+
+        int64_t t_oldest = t_newest - (int64_t)(duration * 1000);
+        records.erase(std::remove_if(records.begin(), records.end(), 
+            [t_oldest](const Flight_Record& record) {return record.t_ms < t_oldest;}), 
+            records.end());
+    }
+
+    return true;
+}
+
+} // namespace tello_basic
@@ -0,0 +1,147 @@
+// frame_grabber.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include "port/frame_grabber.h"
+
+
+namespace tello_basic
+{
+
+// public XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// constructor & destructor ///////////////////////////////////////////////////
+Frame_Grabber::Frame_Grabber(const cv::VideoCapture& cap,
+    const bool& drop_stale_frames)
+    : cap_(cap), drop_stale_frames_(drop_stale_frames),
+      running_(false), num_grabbed_frames_(0), num_dropped_frames_(0) {}
+
+Frame_Grabber::~Frame_Grabber()
+{
+    stop();
+}
+
+// member methods /////////////////////////////////////////////////////////////
+void Frame_Grabber::start()
+{
+    if (running_)
+        return;
+
+    running_ = true;
+    thread_ = std::thread(&Frame_Grabber::grab_loop, this);
+}
+
+// ----------------------------------------------------------------------------
+void Frame_Grabber::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    condition_variable_.notify_all();
+
+    if (thread_.joinable())
+        thread_.join();
+
+    cap_.release();
+}
+
+// ----------------------------------------------------------------------------
+bool Frame_Grabber::get_latest_frame(Frame& frame)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_variable_.wait(lock, [this]
+        {return slot_full_ || stream_ended_ || !running_;});
+
+    if (!slot_full_)
+        return false;
+
+    // hand caller's old buffer back to the slot for reuse
+    std::swap(frame, slot_);
+    slot_full_ = false;
+    lock.unlock();
+
+    condition_variable_.notify_all();
+
+    return true;
+}
+
+// private XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// member methods /////////////////////////////////////////////////////////////
+void Frame_Grabber::grab_loop()
+{
+    Frame frame; // back buffer, only touched by this thread
+
+    while (running_)
+    {
+        // grab returns once a packet is received and decoded
+        Frame_Timing& timing = frame.timing;
+        bool grabbed = cap_.grab();
+        timing.t_grabbed = Clock::now();
+        frame.t_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        if (!grabbed || !cap_.retrieve(frame.image) || frame.image.empty())
+        {
+            std::cerr << "[Frame Grabber] blank frame, stream ended\n";
+            break;
+        }
+        timing.t_retrieved = Clock::now();
+        timing.pts_ms = cap_.get(cv::CAP_PROP_POS_MSEC);
+
+        // arrival of first packet, if known and plausible
+        Timestamp t_arrival;
+        timing.t_arrival = timing.t_grabbed;
+        if (stream_recorder_ != nullptr && 
+            stream_recorder_->get_frame_arrival(timing.pts_ms, t_arrival) && 
+            t_arrival <= timing.t_grabbed)
+        {
+            timing.t_arrival = t_arrival;
+            frame.t_ms -= std::chrono::duration_cast<std::chrono::milliseconds>(
+                timing.t_grabbed - t_arrival).count();
+        }
+
+        // get timestamp
+        frame.timestamp = timing.t_arrival;
+        frame.index = num_grabbed_frames_++;
+        if (metrics_ != nullptr)
+            metrics_->count(Metrics::FRAMES_IN);
+
+        // publish ============================================================
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!drop_stale_frames_)
+        {
+            condition_variable_.wait(lock, [this] {return !slot_full_ || !running_;});
+            if (!running_)
+                break;
+        }
+        else if (slot_full_)
+        {
+            ++num_dropped_frames_; // never pulled
+            if (metrics_ != nullptr)
+                metrics_->count(Metrics::FRAMES_DROPPED);
+        }
+
+        std::swap(frame, slot_);
+        slot_full_ = true;
+        lock.unlock();
+
+        condition_variable_.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stream_ended_ = true;
+    }
+    condition_variable_.notify_all();
+}
+
+} // namespace tello_basic
@@ -0,0 +1,121 @@
+// pose_logger.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include "port/pose_logger.h"
+
+
+namespace tello_basic
+{
+
+// public XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// constructor & destructor ///////////////////////////////////////////////////
+Pose_Logger::Pose_Logger(const size_t& queue_capacity, const size_t& block_size)
+    : queue_(queue_capacity, SPSC_Queue<Pose_Record>::BLOCK), 
+      block_size_(block_size > 0 ? block_size : 1) {}
+
+Pose_Logger::~Pose_Logger()
+{
+    close();
+}
+
+// member methods /////////////////////////////////////////////////////////////
+bool Pose_Logger::open(const std::string& file_path)
+{
+    if (running_)
+        return false;
+
+    stream_.open(file_path, std::ios::binary);
+    if (!stream_.is_open())
+    {
+        std::cerr << "ERROR: could not open pose log " << file_path << std::endl;
+        return false;
+    }
+
+    Pose_Log_Header header;
+    stream_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // closed and possibly holding records from before last close()
+    queue_.reset();
+    num_logged_ = 0;
+    num_dropped_ = 0;
+    running_ = true;
+    thread_ = std::thread(&Pose_Logger::write_loop, this);
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+void Pose_Logger::close()
+{
+    // from now on log() drops, so nothing is queued behind the writer
+    if (!running_.exchange(false))
+        return;
+
+    queue_.close(); // writer drains, then pop() fails
+    if (thread_.joinable())
+        thread_.join();
+
+    stream_.close();
+}
+
+// ----------------------------------------------------------------------------
+bool Pose_Logger::read(const std::string& file_path, std::vector<Pose_Record>& records)
+{
+    std::ifstream stream(file_path, std::ios::binary);
+    if (!stream.is_open())
+    {
+        std::cerr << "ERROR: could not open pose log " << file_path << std::endl;
+        return false;
+    }
+
+    Pose_Log_Header header;
+    if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)) || !header.is_valid())
+    {
+        std::cerr << "ERROR: " << file_path << " is not a pose log" << std::endl;
+        return false;
+    }
+
+    // a truncated last record (e.g. killed while writing) is ignored
+    Pose_Record record;
+    records.clear();
+    while (stream.read(reinterpret_cast<char*>(&record), sizeof(record)))
+        records.push_back(record);
+
+    return true;
+}
+
+// private XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// member methods /////////////////////////////////////////////////////////////
+void Pose_Logger::write_loop()
+{
+    std::vector<Pose_Record> block;
+    block.reserve(block_size_);
+
+    Pose_Record record;
+    while (queue_.pop(record))
+    {
+        // take what has piled up meanwhile, one write for all
+        block.push_back(record);
+        while (block.size() < block_size_ && queue_.try_pop(record))
+            block.push_back(record);
+
+        stream_.write(reinterpret_cast<const char*>(block.data()), 
+            block.size() * sizeof(Pose_Record));
+        stream_.flush(); // hand to kernel, survives a crash of this process
+
+        num_logged_ += block.size();
+        block.clear();
+    }
+}
+
+} // namespace tello_basic
@@ -0,0 +1,368 @@
+// replay_source.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include <sys/stat.h>
+
+#include "port/replay_source.h"
+
+
+namespace tello_basic
+{
+
+// public XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// constructor & destructor ///////////////////////////////////////////////////
+Replay_Source::Replay_Source(const std::string& video_file_path, const double& speed)
+    : video_file_path_(video_file_path), speed_(speed > 0 ? speed : 0) {}
+
+Replay_Source::~Replay_Source()
+{
+    stop();
+}
+
+// getter & setter ////////////////////////////////////////////////////////////
+double Replay_Source::get_duration() const
+{
+    double duration = 0;
+    for (const Replay_Index_Entry& entry : index_)
+        duration = std::max(duration, entry.t_ms);
+
+    return duration;
+}
+
+// member methods /////////////////////////////////////////////////////////////
+bool Replay_Source::open()
+{
+    if (!load_index())
+    {
+        std::cout << "[Replay Source] building index of " << video_file_path_ << std::endl;
+        if (!build_index())
+            return false;
+        save_index();
+    }
+
+    cap_.open(video_file_path_, cv::CAP_FFMPEG);
+    if (!cap_.isOpened())
+    {
+        std::cerr << "ERROR: could not open " << video_file_path_ << std::endl;
+        return false;
+    }
+
+    long num_keyframes = std::count_if(index_.begin(), index_.end(), 
+        [](const Replay_Index_Entry& entry) {return entry.keyframe;});
+    std::cout << "[Replay Source] " << index_.size() << " frames, " << num_keyframes 
+              << " keyframes, " << get_duration() / 1000 << " s"
+              << (arrival_timing_ ? " (arrival times)" : "") << ", speed " 
+              << (speed_ > 0 ? std::to_string(speed_) : "max") << std::endl;
+
+    next_frame_ = 0;
+    anchor_pending_ = true;
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+void Replay_Source::start()
+{
+    stopped_ = false;
+    anchor_pending_ = true;
+}
+
+// ----------------------------------------------------------------------------
+void Replay_Source::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+    }
+    condition_variable_.notify_all();
+}
+
+// ----------------------------------------------------------------------------
+bool Replay_Source::get_latest_frame(Frame& frame)
+{
+    if (stopped_ || !cap_.grab())
+        return false;
+
+    Frame_Timing& timing = frame.timing;
+    timing.pts_ms = cap_.get(cv::CAP_PROP_POS_MSEC);
+    double t_recording_ms = get_recording_time(timing.pts_ms);
+
+    // pace by recording time =================================================
+    if (anchor_pending_)
+    {
+        t_anchor_ = Clock::now();
+        t_recording_anchor_ms_ = t_recording_ms;
+        anchor_pending_ = false;
+    }
+    else if (speed_ > 0)
+    {
+        Timestamp t_due = t_anchor_ + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double, std::milli>((t_recording_ms - t_recording_anchor_ms_) / speed_));
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (condition_variable_.wait_until(lock, t_due, [this] {return stopped_.load();}))
+            return false;
+    }
+
+    timing.t_grabbed = Clock::now();
+    timing.t_arrival = timing.t_grabbed; // paced release stands in for arrival
+    if (!cap_.retrieve(frame.image) || frame.image.empty())
+        return false;
+    timing.t_retrieved = Clock::now();
+
+    // recording time, so output does not depend on wall clock ================
+    frame.timestamp = Timestamp(std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(t_recording_ms)));
+    frame.t_ms = std::llround(t_recording_ms);
+    frame.index = next_frame_++;
+
+    ++num_grabbed_frames_;
+    if (metrics_ != nullptr)
+        metrics_->count(Metrics::FRAMES_IN);
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+bool Replay_Source::seek(const double& t)
+{
+    // first frame at or after t, and last keyframe before it
+    auto target = std::find_if(index_.begin(), index_.end(), 
+        [t](const Replay_Index_Entry& entry) {return entry.t_ms >= t;});
+    if (target == index_.end())
+        return false;
+
+    auto keyframe = target;
+    while (keyframe != index_.begin() && !keyframe->keyframe)
+        --keyframe;
+
+    // demuxer seek lands on keyframe; raw streams cannot seek, decode from start
+    long frame = keyframe->frame;
+    if (!cap_.set(cv::CAP_PROP_POS_FRAMES, frame))
+    {
+        cap_.open(video_file_path_, cv::CAP_FFMPEG);
+        frame = 0;
+    }
+
+    // decode, not show, frames up to target
+    for (; frame < target->frame; ++frame)
+    {
+        if (!cap_.grab())
+            return false;
+    }
+
+    next_frame_ = target->frame;
+    anchor_pending_ = true;
+
+    return true;
+}
+
+// private XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// member methods /////////////////////////////////////////////////////////////
+bool Replay_Source::load_index()
+{
+    std::ifstream stream(get_index_file_path());
+    if (!stream.is_open())
+        return false;
+
+    std::string signature, timing;
+    if (!std::getline(stream, signature) || signature != get_file_signature())
+        return false; // video or its .idx changed since index was built
+    if (!std::getline(stream, timing))
+        return false;
+    arrival_timing_ = timing == "timing arrival";
+
+    index_.clear();
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        Replay_Index_Entry entry;
+        int keyframe;
+        char comma;
+        std::istringstream line_stream(line);
+        if (line_stream >> entry.frame >> comma >> entry.pts_ms >> comma 
+            >> entry.t_ms >> comma >> keyframe)
+        {
+            entry.keyframe = keyframe != 0;
+            index_.push_back(entry);
+        }
+    }
+
+    return !index_.empty();
+}
+
+// ----------------------------------------------------------------------------
+void Replay_Source::save_index() const
+{
+    std::ofstream stream(get_index_file_path());
+    if (!stream.is_open())
+        return; // e.g. read-only directory, rebuilt next time
+
+    stream << get_file_signature() << '\n';
+    stream << (arrival_timing_ ? "timing arrival" : "timing pts") << '\n';
+    stream.precision(12);
+    for (const Replay_Index_Entry& entry : index_)
+    {
+        stream << entry.frame << ',' << entry.pts_ms << ',' << entry.t_ms << ',' 
+            << entry.keyframe << '\n';
+    }
+}
+
+// ----------------------------------------------------------------------------
+bool Replay_Source::build_index()
+{
+    // encoded packets only (CAP_PROP_FORMAT -1), nothing is decoded
+    cv::VideoCapture cap(video_file_path_, cv::CAP_FFMPEG, {cv::CAP_PROP_FORMAT, -1});
+    if (!cap.isOpened())
+    {
+        std::cerr << "ERROR: could not open " << video_file_path_ << std::endl;
+        return false;
+    }
+
+    index_.clear();
+    while (cap.grab())
+    {
+        Replay_Index_Entry entry;
+        entry.frame = index_.size();
+        entry.pts_ms = cap.get(cv::CAP_PROP_POS_MSEC);
+        entry.t_ms = entry.pts_ms;
+        entry.keyframe = cap.get(cv::CAP_PROP_LRF_HAS_KEY_FRAME) > 0;
+        index_.push_back(entry);
+    }
+
+    if (index_.empty())
+    {
+        std::cerr << "ERROR: no frames in " << video_file_path_ << std::endl;
+        return false;
+    }
+
+    // without keyframe flags, seeking decodes from the start
+    index_.front().keyframe = true;
+
+    // raw stream: demuxer counts frames at 25 FPS, arrival is the only clock
+    arrival_timing_ = read_arrival_times();
+    if (!arrival_timing_ && is_raw_stream())
+    {
+        std::cerr << "ERROR: " << video_file_path_ << " is a raw stream without timing, "
+                  << "needs its .idx from tello_stream_record_file" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+bool Replay_Source::read_arrival_times()
+{
+    std::ifstream index_stream(video_file_path_ + ".idx");
+    if (!index_stream.is_open())
+        return false;
+    std::ifstream video_stream(video_file_path_, std::ios::binary);
+
+    // arrival of first slice of each frame, decode order =====================
+    std::vector<double> t_arrivals; // [ms] system clock
+    std::string line;
+    std::getline(index_stream, line); // header
+    while (std::getline(index_stream, line))
+    {
+        long offset, t_ms;
+        int nal_type, keyframe;
+        char comma;
+        std::istringstream line_stream(line);
+        if (!(line_stream >> offset >> comma >> t_ms >> comma >> nal_type >> comma >> keyframe))
+            continue;
+        if (nal_type != 1 && nal_type != 5)
+            continue; // not a slice
+
+        // start code, NAL header, then first_mb_in_slice as ue(v):
+        // 0 (a single 1 bit) on first slice of a frame
+        unsigned char bytes[6];
+        video_stream.seekg(offset);
+        if (!video_stream.read(reinterpret_cast<char*>(bytes), sizeof(bytes)))
+            break; // truncated last unit
+        int header = bytes[2] == 1 ? 3 : 4;
+        if (bytes[header + 1] & 0x80)
+            t_arrivals.push_back(t_ms);
+    }
+
+    // one demuxer packet per frame ===========================================
+    if (t_arrivals.size() != index_.size())
+    {
+        std::cerr << "ERROR: " << video_file_path_ << ".idx lists " << t_arrivals.size() 
+                  << " frames, stream has " << index_.size() << std::endl;
+        return false;
+    }
+
+    double t_last = 0;
+    for (Replay_Index_Entry& entry : index_)
+    {
+        // monotonic, even if system clock stepped back while recording
+        t_last = std::max(t_last, t_arrivals[entry.frame] - t_arrivals.front());
+        entry.t_ms = t_last;
+    }
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+bool Replay_Source::is_raw_stream() const
+{
+    std::string extension = video_file_path_.substr(
+        std::min(video_file_path_.find_last_of('.'), video_file_path_.size()));
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+    return extension == ".h264" || extension == ".264";
+}
+
+// ----------------------------------------------------------------------------
+double Replay_Source::get_recording_time(const double& pts_ms) const
+{
+    if (!arrival_timing_)
+        return pts_ms;
+
+    // raw stream has no reordering: pts increase in decode order
+    auto entry = std::lower_bound(index_.begin(), index_.end(), pts_ms - 0.5, 
+        [](const Replay_Index_Entry& entry, const double& t) {return entry.pts_ms < t;});
+    if (entry == index_.end())
+        --entry;
+
+    return entry->t_ms;
+}
+
+// ----------------------------------------------------------------------------
+std::string Replay_Source::get_file_signature() const
+{
+    struct stat status;
+    if (stat(video_file_path_.c_str(), &status) != 0)
+        return "";
+
+    std::string signature = "replay_index v2 size " + std::to_string(status.st_size) + 
+        " mtime " + std::to_string(status.st_mtime);
+
+    // .idx appearing or changing changes recording times
+    if (stat((video_file_path_ + ".idx").c_str(), &status) == 0)
+    {
+        signature += " idx size " + std::to_string(status.st_size) + 
+            " mtime " + std::to_string(status.st_mtime);
+    }
+
+    return signature;
+}
+
+} // namespace tello_basic
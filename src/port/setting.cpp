@@ -178,7 +178,7 @@ void Setting::read_and_set_tello_camera()
         intrinsic_parameters.push_back(cameraMatrix);
 
         // extrinsics       
-        usb_camera_= std::make_shared<Pinhole>(intrinsic_parameters);
+        tello_camera_= std::make_shared<Pinhole>(intrinsic_parameters);
     }
     else if (camera_model == "Brown-Conrady")
     {
@@ -197,11 +197,35 @@ void Setting::read_and_set_tello_camera()
         // extrinsics       
         tello_camera_= std::make_shared<Brown_Conrady>(intrinsic_parameters);
     }
+    else if (camera_model == "Kannala-Brandt")
+    {
+        std::cout << "setting Kannala-Brandt Tello camera..." << std::endl;
+
+        // read camera intrinsic parameters (D: k1, k2, k3, k4)
+        cv::Mat cameraMatrix = read_parameter<cv::Mat>(file_, "Tello.K", found);
+        cv::Mat distCoeffs = read_parameter<cv::Mat>(file_, "Tello.D", found);
+
+        std::cout << cameraMatrix << std::endl;
+
+        if (distCoeffs.total() != 4)
+        {
+            std::cerr << "ERROR: Kannala-Brandt needs 4 distortion coefficients" << std::endl;
+            exit(-1);
+        }
+        
+        // intrinsics
+        intrinsic_parameters.push_back(cameraMatrix);
+        intrinsic_parameters.push_back(distCoeffs);
+
+        // extrinsics       
+        tello_camera_= std::make_shared<Kannala_Brandt>(intrinsic_parameters);
+    }
     else
     {
         std::cerr << "ERROR: " << camera_model << " not known" << std::endl;
         exit(-1);
     }
+    build_undistortion(tello_camera_, "Tello", cv::Size(960, 720));
     std::cout << "\t-loaded Tello camera" << std::endl;
 }
 
@@ -246,12 +270,52 @@ void Setting::read_and_set_usb_camera()
         // extrinsics       
         usb_camera_= std::make_shared<Brown_Conrady>(intrinsic_parameters);
     }
+    else if (camera_model == "Kannala-Brandt")
+    {
+        std::cout << "setting Kannala-Brandt USB camera..." << std::endl;
+
+        // read camera intrinsic parameters (D: k1, k2, k3, k4)
+        cv::Mat cameraMatrix = read_parameter<cv::Mat>(file_, "USB.K", found);
+        cv::Mat distCoeffs = read_parameter<cv::Mat>(file_, "USB.D", found);
+
+        std::cout << cameraMatrix << std::endl;
+
+        if (distCoeffs.total() != 4)
+        {
+            std::cerr << "ERROR: Kannala-Brandt needs 4 distortion coefficients" << std::endl;
+            exit(-1);
+        }
+        
+        // intrinsics
+        intrinsic_parameters.push_back(cameraMatrix);
+        intrinsic_parameters.push_back(distCoeffs);
+
+        // extrinsics       
+        usb_camera_= std::make_shared<Kannala_Brandt>(intrinsic_parameters);
+    }
     else
     {
         std::cerr << "ERROR: " << camera_model << " not known" << std::endl;
         exit(-1);
     }
+    build_undistortion(usb_camera_, "USB", cv::Size(640, 480));
     std::cout << "\t-loaded USB camera" << std::endl;
 }
 
+// undistortion ===============================================================
+void Setting::build_undistortion(Camera::Ptr camera, 
+    const std::string& camera_name, const cv::Size& default_image_size)
+{
+    bool found_width, found_height;
+    int width  = read_parameter<int>(file_, camera_name + ".width", found_width, false);
+    int height = read_parameter<int>(file_, camera_name + ".height", found_height, false);
+
+    cv::Size image_size = (found_width && found_height) ? 
+        cv::Size(width, height) : default_image_size;
+
+    camera->build_undistortion(image_size);
+    std::cout << "\t-built undistortion tables for " 
+              << image_size.width << "x" << image_size.height << std::endl;
+}
+
 } // namespace tello_basic
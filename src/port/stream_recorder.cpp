@@ -0,0 +1,301 @@
+// stream_recorder.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference: ITU-T H.264 Annex B (byte stream format)
+
+
+#include <cmath>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "port/stream_recorder.h"
+
+
+namespace tello_basic
+{
+
+// public XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// constructor & destructor ///////////////////////////////////////////////////
+Stream_Recorder::Stream_Recorder(const int& listen_port, const int& forward_port)
+    : listen_port_(listen_port), forward_port_(forward_port) {}
+
+Stream_Recorder::~Stream_Recorder()
+{
+    stop();
+}
+
+// getter & setter ////////////////////////////////////////////////////////////
+std::string Stream_Recorder::get_forward_url() const
+{
+    return "tcp://127.0.0.1:" + std::to_string(forward_port_);
+}
+
+// ----------------------------------------------------------------------------
+bool Stream_Recorder::get_frame_arrival(const double& pts_ms, Timestamp& t_arrival) const
+{
+    // demuxer counts forwarded frames from 0
+    long frame = std::lround(pts_ms * demuxer_fps_ / 1000);
+
+    std::lock_guard<std::mutex> lock(arrival_mutex_);
+    if (frame < 0 || frame >= num_forwarded_frames_ || 
+        frame < num_forwarded_frames_ - (long)frame_arrivals_.size())
+        return false;
+
+    t_arrival = frame_arrivals_[frame % frame_arrivals_.size()];
+    return true;
+}
+
+// member methods /////////////////////////////////////////////////////////////
+bool Stream_Recorder::start(const std::string& file_path)
+{
+    if (running_)
+        return false;
+
+    // socket =================================================================
+    socket_ = socket(AF_INET, SOCK_DGRAM, 0);
+    if (socket_ < 0)
+    {
+        std::cerr << "ERROR: could not create stream recorder socket" << std::endl;
+        return false;
+    }
+
+    int buffer_size = 4 << 20; // absorb bursts of a keyframe while writing
+    setsockopt(socket_, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+
+    timeval timeout{0, 100000}; // wake up to notice stop()
+    setsockopt(socket_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(listen_port_);
+    if (bind(socket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+    {
+        std::cerr << "ERROR: could not bind stream recorder to port " << listen_port_ << std::endl;
+        ::close(socket_);
+        socket_ = -1;
+        return false;
+    }
+
+    // decoder connects here; lossless, unlike UDP before it listens
+    forward_socket_ = socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    setsockopt(forward_socket_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in forward_address{};
+    forward_address.sin_family = AF_INET;
+    forward_address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    forward_address.sin_port = htons(forward_port_);
+    if (forward_socket_ < 0 || 
+        bind(forward_socket_, reinterpret_cast<sockaddr*>(&forward_address), sizeof(forward_address)) < 0 || 
+        listen(forward_socket_, 1) < 0)
+    {
+        std::cerr << "ERROR: could not listen for decoder on port " << forward_port_ << std::endl;
+        ::close(forward_socket_);
+        forward_socket_ = -1;
+        ::close(socket_);
+        socket_ = -1;
+        return false;
+    }
+    fcntl(forward_socket_, F_SETFL, O_NONBLOCK); // accepted between datagrams
+
+    // files ==================================================================
+    stream_.open(file_path, std::ios::binary);
+    index_stream_.open(file_path + ".idx");
+    if (!stream_.is_open() || !index_stream_.is_open())
+    {
+        std::cerr << "ERROR: could not open " << file_path << " or its index" << std::endl;
+        stream_.close();
+        index_stream_.close();
+        ::close(forward_socket_);
+        forward_socket_ = -1;
+        ::close(socket_);
+        socket_ = -1;
+        return false;
+    }
+    index_stream_ << "offset,t_ms,nal_type,keyframe\n";
+
+    last_bytes_ = 0xFFFFFFFF;
+    offset_ = 0;
+    forwarding_ = false;
+    slice_started_ = false;
+    {
+        std::lock_guard<std::mutex> lock(arrival_mutex_);
+        frame_arrivals_.assign(256, Timestamp()); // ~8 s of frames
+        num_forwarded_frames_ = 0;
+    }
+    num_packets_ = 0;
+    num_bytes_ = 0;
+    num_keyframes_ = 0;
+
+    running_ = true;
+    thread_ = std::thread(&Stream_Recorder::receive_loop, this);
+    std::cout << "[Stream Recorder] " << listen_port_ << " -> " << file_path 
+              << ", forwarding to " << get_forward_url() << std::endl;
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+void Stream_Recorder::stop()
+{
+    if (!running_)
+        return;
+
+    running_ = false;
+    if (thread_.joinable())
+        thread_.join();
+
+    ::close(socket_);
+    socket_ = -1;
+    if (decoder_socket_ >= 0)
+        ::close(decoder_socket_); // decoder sees end of stream
+    decoder_socket_ = -1;
+    ::close(forward_socket_);
+    forward_socket_ = -1;
+    stream_.close();
+    index_stream_.close();
+
+    std::cout << "[Stream Recorder] " << num_packets_ << " packets, " 
+              << num_bytes_ << " bytes, " << num_keyframes_ << " keyframes." << std::endl;
+}
+
+// private XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// member methods /////////////////////////////////////////////////////////////
+void Stream_Recorder::receive_loop()
+{
+    std::vector<uint8_t> packet(65536); // largest UDP payload
+    const uint8_t start_code[4] = {0, 0, 0, 1};
+
+    while (running_)
+    {
+        accept_decoder();
+
+        ssize_t size = recv(socket_, packet.data(), packet.size(), 0);
+        if (size <= 0)
+            continue; // timeout, check running_
+
+        Timestamp t_arrival = Clock::now();
+        long t_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        bool was_forwarding = forwarding_;
+        size_t forward_from = index_packet(packet.data(), size, t_ms, t_arrival);
+
+        // decoder first, it is waiting
+        if (forward_from < (size_t)size)
+        {
+            if (!was_forwarding)
+                forward(start_code, sizeof(start_code)); // of the SPS
+            forward(packet.data() + forward_from, size - forward_from);
+        }
+
+        stream_.write(reinterpret_cast<const char*>(packet.data()), size);
+        offset_ += size;
+
+        ++num_packets_;
+        num_bytes_ += size;
+    }
+}
+
+// ----------------------------------------------------------------------------
+void Stream_Recorder::accept_decoder()
+{
+    if (decoder_socket_ >= 0)
+        return;
+
+    int decoder_socket = accept(forward_socket_, nullptr, nullptr);
+    if (decoder_socket < 0)
+        return; // none pending
+
+    int no_delay = 1;
+    setsockopt(decoder_socket, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+    decoder_socket_ = decoder_socket;
+
+    // new demuxer, counts from 0 again
+    std::lock_guard<std::mutex> lock(arrival_mutex_);
+    num_forwarded_frames_ = 0;
+    std::cout << "[Stream Recorder] decoder connected, forwarding from next keyframe." << std::endl;
+}
+
+// ----------------------------------------------------------------------------
+void Stream_Recorder::forward(const uint8_t* data, const size_t& size)
+{
+    if (decoder_socket_ < 0)
+        return;
+
+    // blocking: a slow decoder holds back receiving, nothing is lost
+    if (send(decoder_socket_, data, size, MSG_NOSIGNAL) == (ssize_t)size)
+        return;
+
+    std::cerr << "[Stream Recorder] decoder disconnected\n";
+    ::close(decoder_socket_);
+    decoder_socket_ = -1;
+    forwarding_ = false;
+}
+
+// ----------------------------------------------------------------------------
+size_t Stream_Recorder::index_packet(const uint8_t* data, const size_t& size, 
+    const long& t_ms, const Timestamp& t_arrival)
+{
+    size_t forward_from = forwarding_ ? 0 : size;
+
+    // start code 00 00 01, possibly split over datagrams; next byte is NAL header
+    for (size_t i = 0; i < size; ++i)
+    {
+        // slice header starts with first_mb_in_slice as ue(v):
+        // 0 (a single 1 bit) on first slice of a frame
+        if (slice_started_ && forwarding_ && (data[i] & 0x80))
+        {
+            std::lock_guard<std::mutex> lock(arrival_mutex_);
+            frame_arrivals_[num_forwarded_frames_ % frame_arrivals_.size()] = t_slice_;
+            ++num_forwarded_frames_;
+        }
+        slice_started_ = false;
+
+        if ((last_bytes_ & 0x00FFFFFF) == 0x000001)
+        {
+            int nal_type = data[i] & 0x1F;
+            bool keyframe = nal_type == 5 || nal_type == 7; // IDR slice, SPS
+
+            // offset of start code; 4-byte form when preceded by a zero
+            long offset = offset_ + (long)i - ((last_bytes_ & 0xFF000000) == 0 ? 4 : 3);
+            index_stream_ << offset << ',' << t_ms << ',' << nal_type << ',' << keyframe << '\n';
+
+            if (nal_type == 7)
+            {
+                ++num_keyframes_; // SPS leads each keyframe
+
+                // decoder starts on a keyframe, from this NAL header
+                if (!forwarding_ && decoder_socket_ >= 0)
+                {
+                    forwarding_ = true;
+                    forward_from = i;
+                }
+            }
+            else if (nal_type == 1 || nal_type == 5)
+            {
+                slice_started_ = true;
+                t_slice_ = t_arrival;
+            }
+        }
+        last_bytes_ = (last_bytes_ << 8) | data[i];
+    }
+
+    return forward_from;
+}
+
+} // namespace tello_basic
@@ -69,8 +69,45 @@ bool System::initialize()
     aruco_detector_ = std::make_shared<ArUco_Detector>(
         target_id, predifined_dictionary_name_, marker_length_, mono_camera_);
     aruco_detector_->set_verbose(verbose);
+
+    // Pose Filter ------------------------------------------------------------
+    if (Config::read<int>("pose_filter") != 0)
+    {
+        pose_filter_ = std::make_shared<Pose_Filter>();
+        aruco_detector_->set_pose_filter(pose_filter_);
+    }
+
+    // Flight Recorder --------------------------------------------------------
+    std::string flight_recorder_file_path = Config::read<std::string>("flight_recorder_file");
+    if (!flight_recorder_file_path.empty())
+    {
+        int flight_recorder_capacity = Config::read<int>("flight_recorder_capacity");
+        flight_recorder_capacity = flight_recorder_capacity > 0 ? flight_recorder_capacity : 65536;
+
+        flight_recorder_ = std::make_shared<Flight_Recorder>();
+        if (flight_recorder_->open(flight_recorder_file_path, flight_recorder_capacity))
+            aruco_detector_->set_flight_recorder(flight_recorder_);
+        else
+            flight_recorder_ = nullptr;
+    }
+
+    // Metrics ----------------------------------------------------------------
+    // always recorded; written to file only if metrics_file is set
+    std::string metrics_file_path = Config::read<std::string>("metrics_file");
+    if (!metrics_file_path.empty())
+    {
+        double metrics_period = Config::read<double>("metrics_period");
+        metrics_period = metrics_period > 0 ? metrics_period : 1.0; // [s]
+        aruco_detector_->get_metrics()->start_writing(metrics_file_path, metrics_period);
+    }
     
     return true;
 }
 
+// ----------------------------------------------------------------------------
+Metrics::Snapshot System::get_metrics_snapshot() const
+{
+    return aruco_detector_->get_metrics()->snapshot();
+}
+
 } // namespace tello_basic
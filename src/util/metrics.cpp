@@ -0,0 +1,154 @@
+// metrics.cpp
+
+/////////////////////////
+// IONLAB ISAE-SUPAERO //
+// TELLO SLAM PROJECT  //
+/////////////////////////
+
+// 2026 OCT 17
+// Wonhee LEE
+
+// reference:
+
+
+#include "util/metrics.h"
+
+
+namespace tello_basic
+{
+
+const char* const Metrics::stage_names[NUM_STAGES] = 
+    {"decode", "retrieve", "queue", "grayscale", "detect", "pose", "output", "total"};
+
+const char* const Metrics::counter_names[NUM_COUNTERS] = 
+    {"frames_in", "frames_dropped", "detections", "target_hits"};
+
+// ============================================================================
+void Metrics::Snapshot::write_json(std::ostream& stream) const
+{
+    stream << "{\"t_ms\": " << t_ms << ", \"uptime\": " << uptime;
+    for (int i = 0; i < NUM_COUNTERS; ++i)
+        stream << ", \"" << counter_names[i] << "\": " << counters[i];
+
+    stream << ", \"stages_ms\": {";
+    for (int i = 0; i < NUM_STAGES; ++i)
+    {
+        const Latency_Histogram::Snapshot& stage = stages[i];
+        stream << (i > 0 ? ", " : "") << "\"" << stage_names[i] << "\": {"
+               << "\"count\": " << stage.count << ", "
+               << "\"mean\": " << stage.mean << ", "
+               << "\"p50\": " << stage.percentile(50) << ", "
+               << "\"p90\": " << stage.percentile(90) << ", "
+               << "\"p99\": " << stage.percentile(99) << ", "
+               << "\"max\": " << stage.max << "}";
+    }
+    stream << "}}\n";
+}
+
+// public XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// constructor & destructor ///////////////////////////////////////////////////
+Metrics::Metrics()
+{
+    reset();
+}
+
+Metrics::~Metrics()
+{
+    stop_writing();
+}
+
+// member methods /////////////////////////////////////////////////////////////
+Metrics::Snapshot Metrics::snapshot() const
+{
+    Snapshot snapshot;
+    snapshot.t_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    snapshot.uptime = std::chrono::duration<double>(Clock::now() - 
+        Timestamp(Clock::duration(t_reset_.load(std::memory_order_relaxed)))).count();
+
+    for (int i = 0; i < NUM_STAGES; ++i)
+        snapshot.stages[i] = histograms_[i].snapshot();
+    for (int i = 0; i < NUM_COUNTERS; ++i)
+        snapshot.counters[i] = counters_[i].load(std::memory_order_relaxed);
+
+    return snapshot;
+}
+
+// ----------------------------------------------------------------------------
+void Metrics::record(const Frame_Timing& timing)
+{
+    record(DECODE, timing.t_arrival, timing.t_grabbed);
+    record(RETRIEVE, timing.t_grabbed, timing.t_retrieved);
+    record(QUEUE, timing.t_retrieved, timing.t_pulled);
+    record(GRAYSCALE, timing.t_pulled, timing.t_grayscale);
+    record(DETECT, timing.t_grayscale, timing.t_detected);
+    record(POSE, timing.t_detected, timing.t_posed);
+    record(OUTPUT, timing.t_posed, timing.t_output);
+    record(TOTAL, timing.t_arrival, timing.t_output);
+}
+
+// ----------------------------------------------------------------------------
+void Metrics::reset()
+{
+    for (Latency_Histogram& histogram : histograms_)
+        histogram.reset();
+    for (std::atomic<long>& counter : counters_)
+        counter.store(0, std::memory_order_relaxed);
+
+    t_reset_.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------------------------------
+bool Metrics::start_writing(const std::string& file_path, const double& period)
+{
+    stop_writing();
+
+    std::ofstream stream(file_path, std::ios::app);
+    if (!stream.is_open())
+    {
+        std::cerr << "ERROR: could not open metrics file " << file_path << std::endl;
+        return false;
+    }
+
+    writing_ = true;
+    thread_ = std::thread(&Metrics::write_loop, this, std::move(stream), 
+        std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(period)));
+    std::cout << "[Metrics] writing to " << file_path << " every " << period << " s." << std::endl;
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+void Metrics::stop_writing()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        writing_ = false;
+    }
+    condition_variable_.notify_all();
+
+    if (thread_.joinable())
+        thread_.join();
+}
+
+// private XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+// member methods /////////////////////////////////////////////////////////////
+void Metrics::write_loop(std::ofstream stream, const Clock::duration period)
+{
+    Timestamp t_next = Clock::now() + period;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (writing_)
+    {
+        condition_variable_.wait_until(lock, t_next, [this] {return !writing_;});
+        t_next += period;
+
+        // file I/O off the lock, stop_writing() must not wait on disk
+        lock.unlock();
+        snapshot().write_json(stream);
+        stream.flush();
+        lock.lock();
+    }
+}
+
+} // namespace tello_basic
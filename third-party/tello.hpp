@@ -640,6 +640,11 @@ public:
 		float agx = 0.f;			// Accelerometer measurement X-Axis
 		float agy = 0.f;			// Accelerometer measurement Y-Axis
 		float agz = 0.f;			// Accelerometer measurement Z-Axis
+
+		// Set by the receiver, to tell new packets from repeated reads
+		uint64_t sequence = 0;		// Number of state packets received so far
+		std::chrono::steady_clock::time_point arrival;			// When this packet was received
+		std::chrono::system_clock::time_point arrival_system;	// Same, on the wall clock
 	};
 
 public:
@@ -881,6 +886,9 @@ private:
 	}
 
 	void OnDataStream(std::string data) {
+		auto arrival = std::chrono::steady_clock::now();
+		auto arrival_system = std::chrono::system_clock::now();
+
 		// Parse the Tello state string
 
 		std::vector<std::string> tokens;
@@ -919,6 +927,10 @@ private:
 			else if (first == "agy")	_state.agy = std::stof(second) / 100.f;	  // float
 			else if (first == "agz")	_state.agz = std::stof(second) / 100.f;	  // float
 		}
+
+		_state.sequence++;
+		_state.arrival = arrival;
+		_state.arrival_system = arrival_system;
 	}
 
 private: